@@ -1,34 +1,25 @@
 #version 330 core
 
 // Definitions and types
-#define MAX_LIGHTS 20
+#define MAX_LIGHTS 128 // Must match `sf3d::RenderTarget::maxLightPoints`
+#define MAX_OBJECT_LIGHTS 16 // Must match `sf3d::RenderTarget::maxLightPointsPerObjectLimit`
 #define ENABLE_ATTENUATION
 
-struct Attenuation
-{
-    float constant;
-    float linear;
-    float quadratic;
-};
-
+// Layout of point light in `PointLights` block (std140)
 struct PointLight
 {
     // Standard
-    vec3 position;
-    vec3 color;
-
-    float colorR;
-    float colorG;
-    float colorB;
+    vec4 position;      // xyz
+    vec4 color;         // rgb
 
     // Attenuation
-    Attenuation attenuation;
+    vec4 attenuation;   // x - constant, y - linear, z - quadratic
     
     // Light factors
-    vec3 ambientFactor;
-    vec3 diffuseFactor;
+    vec4 ambientFactor; // rgb
+    vec4 diffuseFactor; // rgb
 #ifdef ENABLE_SPECULAR
-    vec3 specularFactor;
+    vec4 specularFactor;
 #endif
 };
 
@@ -59,8 +50,16 @@ uniform Material material;
 uniform vec3 cameraPosition;
 uniform vec3 basicAmbient = vec3(1.0, 1.0, 1.0);
 
-uniform uint pointLightsLength = 0u;
-uniform PointLight pointLights[MAX_LIGHTS];
+// Uploaded once per frame by render target
+layout (std140) uniform PointLights
+{
+    uint pointLightsLength;
+    PointLight pointLights[MAX_LIGHTS];
+};
+
+// Indices of lights which reach currently drawn object
+uniform uint objectLightsLength = 0u;
+uniform uint objectLights[MAX_OBJECT_LIGHTS];
 
 
 
@@ -85,8 +84,8 @@ void main()
             vec3 color = pixel.rgb * basicAmbient;
 
             // Point lights
-            for (uint i = 0u; i < pointLightsLength; ++i) {
-                color += calucaltePointLight(pointLights[i], normal, fragmentPosition, cameraDirection);
+            for (uint i = 0u; i < objectLightsLength; ++i) {
+                color += calucaltePointLight(pointLights[objectLights[i]], normal, fragmentPosition, cameraDirection);
             }
 
             // Apply transparency
@@ -105,23 +104,23 @@ vec3 calucaltePointLight(PointLight light, vec3 normal, vec3 fragmentPosition, v
 {
     // Distance
 #ifdef ENABLE_ATTENUATION
-    float lightDistance = distance(light.position, fragmentPosition);
+    float lightDistance = distance(light.position.xyz, fragmentPosition);
     float attenuation = 1.0 / (
         // x^0
-        light.attenuation.constant + 
+        light.attenuation.x + 
         lightDistance * (
             // x^1
-            light.attenuation.linear + 
+            light.attenuation.y + 
             lightDistance * (
                 // x^2
-                light.attenuation.quadratic
+                light.attenuation.z
             )
         )
     );
 #endif
 
     // Direction
-    vec3 lightDirection = normalize(light.position - fragmentPosition);
+    vec3 lightDirection = normalize(light.position.xyz - fragmentPosition);
     float diffusePositionFactor = max(dot(normal, lightDirection), 0.0);
     
 #ifdef ENABLE_SPECULAR
@@ -135,13 +134,13 @@ vec3 calucaltePointLight(PointLight light, vec3 normal, vec3 fragmentPosition, v
     vec3 result;
 
     result = (
-        light.ambientFactor +
-        light.diffuseFactor * diffusePositionFactor
+        light.ambientFactor.rgb +
+        light.diffuseFactor.rgb * diffusePositionFactor
     ) * texture(material.diffuseTexture, fragmentTexCoord).rgb;
 
 #ifdef ENABLE_SPECULAR
     result += (
-        light.specularFactor * specularPositionFactor
+        light.specularFactor.rgb * specularPositionFactor
     ) * texture(material.specularTexture, fragmentTexCoord).rgb;
 #endif
 
@@ -150,7 +149,7 @@ vec3 calucaltePointLight(PointLight light, vec3 normal, vec3 fragmentPosition, v
 #endif
 
     // Return result
-    return result * light.color;
+    return result * light.color.rgb;
 }
 
 
@@ -2,6 +2,8 @@
 #include "Szczur/Utility/Tests.hpp"
 
 #include "Utility/MsgBox.hpp"
+#include "Utility/FileWatcher.hpp"
+#include "Utility/Profiler.hpp"
 #ifdef EDITOR
 #	include <imgui.h>
 #	include <imgui-SFML.h>
@@ -15,6 +17,8 @@ void Application::init()
 {
 	LOG_INFO("Initializing modules");
 
+	Profiler::get().setThreadName("Main");
+
 	initModule<Window>();
 	initModule<Script>();
 	initModule<Input>();
@@ -60,6 +64,17 @@ void Application::input()
 		getModule<Input>().getManager().processEvent(event);
 		getModule<GUI>().input(event);
 
+		// Trace can be saved also outside editor, to find spikes on player machines
+		if (event.type == sf::Event::KeyPressed && event.key.code == sf::Keyboard::F12 && event.key.control) {
+			try {
+				Profiler::get().saveChromeTrace("Profile.json");
+				LOG_INFO("Profiler trace saved to Profile.json");
+			}
+			catch (const std::exception& exc) {
+				LOG_EXCEPTION(exc);
+			}
+		}
+
 		#ifdef EDITOR
 		{
 			ImGui::SFML::ProcessEvent(event);
@@ -86,14 +101,35 @@ void Application::input()
 
 void Application::update()
 {
+	Profiler::get().beginFrame();
+	PROFILE_FUNCTION();
+
+	// Reload files changed since last frame
+	{
+		PROFILE_SCOPE("FileWatcher");
+		FileWatcher::get().applyChanges();
+	}
+
 	_imGuiStyler.update();
 
 	auto deltaTime = _mainClock.restart().asFSeconds();
 	
-	getModule<GUI>().update(deltaTime);
-	getModule<Dialog>().update();
-	getModule<Music>().update(deltaTime);
-	getModule<Equipment>().update(deltaTime);
+	{
+		PROFILE_SCOPE("GUI::update");
+		getModule<GUI>().update(deltaTime);
+	}
+	{
+		PROFILE_SCOPE("Dialog::update");
+		getModule<Dialog>().update();
+	}
+	{
+		PROFILE_SCOPE("Music::update");
+		getModule<Music>().update(deltaTime);
+	}
+	{
+		PROFILE_SCOPE("Equipment::update");
+		getModule<Equipment>().update(deltaTime);
+	}
 
 	#ifdef EDITOR
 	{
@@ -101,31 +137,53 @@ void Application::update()
 	}
 	#endif
 
-	getModule<World>().update(deltaTime);
+	{
+		PROFILE_SCOPE("World::update");
+		getModule<World>().update(deltaTime);
+	}
 	getModule<Input>().getManager().finishLogic();
-	getModule<Cinematics>().update();
+	{
+		PROFILE_SCOPE("Cinematics::update");
+		getModule<Cinematics>().update();
+	}
 }
 
 void Application::render()
 {
+	PROFILE_FUNCTION();
+
 	getModule<Window>().clear({24u, 20u, 28u, 255u});
 
-	getModule<World>().render();
+	{
+		PROFILE_SCOPE("World::render");
+		getModule<World>().render();
+	}
 	
-	getModule<Window>().pushGLStates();
-	getModule<GUI>().render();
-	getModule<Window>().popGLStates();
-	getModule<Cinematics>().render();
+	{
+		PROFILE_SCOPE("GUI::render");
+		getModule<Window>().pushGLStates();
+		getModule<GUI>().render();
+		getModule<Window>().popGLStates();
+	}
+	{
+		PROFILE_SCOPE("Cinematics::render");
+		getModule<Cinematics>().render();
+	}
 
 	// getModule<World>().render();
 
 	#ifdef EDITOR
 	{
+		PROFILE_SCOPE("ImGui::render");
 		ImGui::SFML::Render(getModule<Window>().getWindow());
 	}
 	#endif
 	
-	getModule<Window>().render();
+	{
+		// Includes waiting for vertical sync
+		PROFILE_SCOPE("Window::display");
+		getModule<Window>().render();
+	}
 }
 int Application::run()
 {
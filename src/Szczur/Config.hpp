@@ -50,5 +50,10 @@
 #	include <imgui-SFML.h>
 #endif
 
+// Profiler zones, also in release builds to find spikes on player machines
+#if !defined(NO_PROFILER)
+#	define PROFILER
+#endif
+
 // Global helper for modules system
 namespace rat::detail { template <typename T> inline T* globalPtr = nullptr; }
@@ -11,6 +11,8 @@
 
 DRAGONBONES_NAMESPACE_BEGIN
 
+bool SF3DArmatureDisplay::_merging = true;
+
 SF3DArmatureDisplay::SF3DArmatureDisplay()
 {
 	_armature = nullptr;
@@ -63,6 +65,60 @@ void SF3DArmatureDisplay::dispose(bool disposeProxy)
 }
 
 void SF3DArmatureDisplay::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
+{
+	// Batch already merges slots sharing texture, copying them into merged arrays first would only add work
+	if (!_merging || target.isBatching())
+	{
+		_drawSlots(target, states);
+		return;
+	}
+
+	// Slots are sorted by z-order, so runs of same texture keep drawing order
+	_mergedPartsCount = 0;
+	_mergedVertices.clear();
+	_mergedIndices.clear();
+
+	const sf3d::Texture* texture = nullptr;
+
+	for (auto slot : _armature->getSlots())
+	{
+		if (!slot)
+			continue;
+
+		auto display = static_cast<SF3DDisplay*>(slot->getRawDisplay());
+
+		if (!display || !display->visible || display->verticesDisplay.isEmpty())
+			continue;
+
+		if (display->texture != texture)
+		{
+			_flushMergedPart(texture);
+			texture = display->texture;
+		}
+
+		display->appendTo(_mergedVertices, _mergedIndices);
+	}
+
+	_flushMergedPart(texture);
+
+	for (std::size_t i = 0; i < _mergedPartsCount; ++i)
+	{
+		states.texture = _mergedParts[i].texture;
+		target.draw(_mergedParts[i].vertices, states);
+	}
+}
+
+void SF3DArmatureDisplay::setMerging(bool merging)
+{
+	_merging = merging;
+}
+
+bool SF3DArmatureDisplay::isMerging()
+{
+	return _merging;
+}
+
+void SF3DArmatureDisplay::_drawSlots(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 {
 	for (auto slot : _armature->getSlots())
 	{
@@ -78,6 +134,33 @@ void SF3DArmatureDisplay::draw(sf3d::RenderTarget& target, sf3d::RenderStates st
 	}
 }
 
+void SF3DArmatureDisplay::_flushMergedPart(const sf3d::Texture* texture) const
+{
+	if (_mergedIndices.empty())
+	{
+		_mergedVertices.clear();
+		return;
+	}
+
+	if (_mergedPartsCount == _mergedParts.size())
+	{
+		_mergedParts.emplace_back();
+	}
+
+	auto& part = _mergedParts[_mergedPartsCount++];
+	part.texture = texture;
+	part.vertices.assign(_mergedVertices.data(), _mergedVertices.size(), sf3d::PrimitiveType::Triangles);
+
+	// Indices change only when slots change displays or visibility
+	if (part.vertices.getIndices() != _mergedIndices)
+	{
+		part.vertices.setIndices(_mergedIndices);
+	}
+
+	_mergedVertices.clear();
+	_mergedIndices.clear();
+}
+
 sf::FloatRect SF3DArmatureDisplay::getBoundingBox()
 {
 	auto slots = _armature->getSlots();
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <vector>
+
 #include <dragonBones/DragonBonesHeaders.h>
 
 #include <SFML/Graphics/Rect.hpp>
@@ -24,6 +26,23 @@ protected:
 	Armature*									_armature = nullptr;
 	SFMLEventDispatcher							_dispatcher;
 
+	/// Consecutive slots sharing texture, drawn by one call
+	struct MergedPart
+	{
+		const sf3d::Texture* texture = nullptr;
+		sf3d::VertexArray vertices {sf3d::PrimitiveType::Triangles};
+	};
+
+	static bool									_merging;
+
+	bool										_meshDeformEnabled = true;
+
+	// Parts are kept between frames, so their buffers are only updated
+	mutable std::vector<MergedPart>				_mergedParts;
+	mutable std::size_t							_mergedPartsCount = 0;
+	mutable std::vector<sf3d::Vertex>			_mergedVertices;
+	mutable sf3d::VertexArray::Indices_t		_mergedIndices;
+
 public:
 	SF3DArmatureDisplay();
 	~SF3DArmatureDisplay();
@@ -42,8 +61,26 @@ public:
 	Armature* getArmature() const override { return _armature; }
 	Animation* getAnimation() const override { return _armature->getAnimation(); }
 
+	/// Draws visible slots in z-order, merged into one vertex array for each run of slots sharing texture unless target is batching
 	void draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const;
 
+	/// Number of draws issued by last merged `draw`
+	std::size_t getMergedPartsCount() const { return _mergedPartsCount; }
+
+	/// Meshes keep their last pose while deformation is off, they are updated again once it is turned back on
+	void setMeshDeformEnabled(bool enabled) { _meshDeformEnabled = enabled; }
+	bool isMeshDeformEnabled() const { return _meshDeformEnabled; }
+
+	/// Merging can be turned off to draw each slot separately
+	static void setMerging(bool merging);
+	static bool isMerging();
+
+private:
+	void _drawSlots(sf3d::RenderTarget& target, sf3d::RenderStates states) const;
+	void _flushMergedPart(const sf3d::Texture* texture) const;
+
+public:
+
 	sf::FloatRect getBoundingBox();
 };
 
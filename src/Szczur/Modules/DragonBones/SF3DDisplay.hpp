@@ -30,7 +30,7 @@ class SF3DDisplay
 public:
 	const sf3d::Texture* texture = nullptr;
 
-	std::vector<std::vector<int>> 			verticesInTriagles;
+	// Meshes keep each vertex once, with triangles as indices
 	sf3d::VertexArray		 				verticesDisplay {4u, sf3d::PrimitiveType::TriangleFan};
 
 	bool visible = true;
@@ -80,6 +80,45 @@ public:
 		}
 	}
 
+	/// Appends vertices with transform of display already applied, primitives are turned into indexed triangles
+	void appendTo(std::vector<sf3d::Vertex>& vertices, sf3d::VertexArray::Indices_t& indices) const
+	{
+		const glm::mat4& matrix = this->transform.getMatrix();
+		const sf3d::Vertex* data = this->verticesDisplay.getData();
+		const std::size_t size = this->verticesDisplay.getSize();
+		const GLuint base = static_cast<GLuint>(vertices.size());
+
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			auto& vertex = vertices.emplace_back(data[i]);
+			vertex.position = glm::vec3(matrix * glm::vec4(data[i].position, 1.f));
+		}
+
+		if (this->verticesDisplay.isIndexed())
+		{
+			for (auto index : this->verticesDisplay.getIndices())
+			{
+				indices.push_back(base + index);
+			}
+		}
+		else if (this->verticesDisplay.getPrimitiveType() == sf3d::PrimitiveType::TriangleFan)
+		{
+			for (std::size_t i = 1; i + 1 < size; ++i)
+			{
+				indices.push_back(base);
+				indices.push_back(base + static_cast<GLuint>(i));
+				indices.push_back(base + static_cast<GLuint>(i + 1));
+			}
+		}
+		else
+		{
+			for (std::size_t i = 0; i < size - size % 3; ++i)
+			{
+				indices.push_back(base + static_cast<GLuint>(i));
+			}
+		}
+	}
+
 	sf::FloatRect getBoundingBox()
 	{
 		if (texture == nullptr)
@@ -4,8 +4,7 @@
 
 #include "SF3DFactory.hpp"
 
-#include <fstream>
-#include <sstream>
+#include <string>
 
 #include <SFML/Graphics.hpp>
 
@@ -56,36 +55,56 @@ DragonBonesData* SF3DFactory::loadDragonBonesData(const std::string& filePath, c
 			return existedData;
 	}
 
-	std::stringstream data;
+	rat::MappedFile file;
 
-	std::ifstream json(filePath);
-
-	if (json.bad())
-		return nullptr;
-
-	data << json.rdbuf();
-
-	if (data.str().empty())
+	try
+	{
+		file.open(filePath);
+	}
+	catch (const std::exception&)
+	{
 		return nullptr;
+	}
 
-	return parseDragonBonesData(data.str().c_str(), name, 1.0f);
+	return loadDragonBonesData(file, name);
 }
 
 TextureAtlasData* SF3DFactory::loadTextureAtlasData(const std::string& filePath, sf3d::Texture* atlasTexture, const std::string& name, float scale)
 {
-	std::stringstream data;
-
-	std::ifstream json(filePath);
+	rat::MappedFile file;
 
-	if (json.bad())
+	try
+	{
+		file.open(filePath);
+	}
+	catch (const std::exception&)
+	{
 		return nullptr;
+	}
 
-	data << json.rdbuf();
+	return loadTextureAtlasData(file, atlasTexture, name, scale);
+}
 
-	if (data.str().empty())
-		return nullptr;
+DragonBonesData* SF3DFactory::loadDragonBonesData(const rat::MappedFile& file, const std::string& name)
+{
+	if (!name.empty())
+	{
+		const auto existedData = getDragonBonesData(name);
 
-	return static_cast<SF3DTextureAtlasData*>(BaseFactory::parseTextureAtlasData(data.str().c_str(), atlasTexture, name, scale));
+		if (existedData)
+			return existedData;
+	}
+
+	return _parseMapped(file, [&] (const char* data) {
+		return parseDragonBonesData(data, name, 1.0f);
+	});
+}
+
+TextureAtlasData* SF3DFactory::loadTextureAtlasData(const rat::MappedFile& file, sf3d::Texture* atlasTexture, const std::string& name, float scale)
+{
+	return _parseMapped(file, [&] (const char* data) {
+		return static_cast<SF3DTextureAtlasData*>(BaseFactory::parseTextureAtlasData(data, atlasTexture, name, scale));
+	});
 }
 
 TextureAtlasData* SF3DFactory::createTextureAtlasData(std::vector<SF3DTextureData*>& texturesData, DragonBonesData* dragonBonesData)
@@ -14,6 +14,7 @@
 #include "SF3DTextureData.hpp"
 
 #include "Szczur/Utility/SFML3D/Texture.hpp"
+#include "Szczur/Utility/MappedFile.hpp"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -32,6 +33,10 @@ public:
 public:
 	DragonBonesData* loadDragonBonesData(const std::string& filePath, const std::string& name = "");
 	TextureAtlasData* loadTextureAtlasData(const std::string& filePath, sf3d::Texture *atlasTexture, const std::string& name = "", float scale = 1.0f);
+
+	/// Parses straight from mapped file, without copying it into string
+	DragonBonesData* loadDragonBonesData(const rat::MappedFile& file, const std::string& name = "");
+	TextureAtlasData* loadTextureAtlasData(const rat::MappedFile& file, sf3d::Texture *atlasTexture, const std::string& name = "", float scale = 1.0f);
 	SF3DArmatureDisplay* buildArmatureDisplay(const std::string& armatureName, const std::string& dragonBonesName = "", const std::string& skinName = "", const std::string& textureAtlasName = "") const;
 	sf3d::Texture* getTextureDisplay(const std::string& textureName, const std::string& dragonBonesName = "") const;
 
@@ -47,6 +52,24 @@ public:
 	static SF3DFactory* get() { return _factory; }
 
 protected:
+	/// Parser needs terminated string. Mapping is zero-filled up to end of its last page, so only files filling whole pages are copied
+	template <typename F>
+	static auto _parseMapped(const rat::MappedFile& file, F&& parse) -> decltype(parse(""))
+	{
+		const std::size_t pageSize = rat::MappedFile::getPageSize();
+
+		if (file.getSize() == 0)
+			return nullptr;
+
+		const char* data = reinterpret_cast<const char*>(file.getData());
+
+		if (file.getSize() % pageSize != 0)
+			return parse(data);
+
+		const std::string copy(data, file.getSize());
+		return parse(copy.c_str());
+	}
+
 	TextureAtlasData* _buildTextureAtlasData(TextureAtlasData* textureAtlasData, void* textureAtlas) const override;
 	Armature* _buildArmature(const BuildArmaturePackage& dataPackage) const override;
 	Slot* _buildSlot(const BuildArmaturePackage& dataPackage, const SlotData* slotData, Armature* armature) const override;
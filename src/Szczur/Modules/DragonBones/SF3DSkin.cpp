@@ -0,0 +1,292 @@
+/** @file SF3DSkin.cpp
+** @description Skinning of DragonBones meshes, working on few vertices at once.
+**/
+
+#include "SF3DSkin.hpp"
+
+#include <algorithm>
+
+// Vector kernel is chosen by compiler flags, x86-64 always has SSE2
+#if defined(__AVX2__)
+	#include <immintrin.h>
+	#define SF3D_SKIN_AVX2
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+	#include <emmintrin.h>
+	#define SF3D_SKIN_SSE2
+#endif
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+namespace
+{
+	// Bone matrix as { a, b, c, d, tx, ty, 0, 0 }, so it can be loaded by two 4-float registers
+	constexpr std::size_t PaletteStride = 8;
+}
+
+bool SF3DSkin::vectorized = true;
+
+/* Methods */
+void SF3DSkin::build(const VerticesData& verticesData, std::size_t bonesCount, float scale)
+{
+	const auto weightData = verticesData.weight;
+	const int16_t* intArray = verticesData.data->intArray;
+	const float* floatArray = verticesData.data->floatArray;
+
+	this->verticesData = &verticesData;
+	this->scale = scale;
+	this->bonesCount = bonesCount;
+	this->vertexCount = intArray[verticesData.offset + (std::size_t)BinaryOffset::MeshVertexCount];
+	this->stride = (this->vertexCount + Lanes - 1) / Lanes * Lanes;
+
+	int weightFloatOffset = intArray[weightData->offset + (std::size_t)BinaryOffset::WeigthFloatOffset];
+	if (weightFloatOffset < 0)
+	{
+		weightFloatOffset += 65536;
+	}
+	const std::size_t bonesIndex = weightData->offset + (std::size_t)BinaryOffset::WeigthBoneIndices + bonesCount;
+
+	// Most influences of single vertex decide number of streams
+	this->influencesCount = 0;
+	for (std::size_t i = 0, index = bonesIndex; i < this->vertexCount; ++i)
+	{
+		const std::size_t count = intArray[index];
+		this->influencesCount = std::max(this->influencesCount, count);
+		index += count + 1;
+	}
+
+	const std::size_t size = this->influencesCount * this->stride;
+	this->boneIndices.assign(size, static_cast<std::int32_t>(bonesCount));
+	this->weights.assign(size, 0.f);
+	this->localX.assign(size, 0.f);
+	this->localY.assign(size, 0.f);
+	this->deformIndices.assign(size, -1);
+
+	std::size_t index = bonesIndex;
+	std::size_t floatIndex = weightFloatOffset;
+	std::int32_t deformIndex = 0;
+	for (std::size_t i = 0; i < this->vertexCount; ++i)
+	{
+		const std::size_t count = intArray[index++];
+		for (std::size_t j = 0; j < count; ++j)
+		{
+			const std::size_t k = j * this->stride + i;
+
+			this->boneIndices[k] = std::min<std::int32_t>(intArray[index++], static_cast<std::int32_t>(bonesCount));
+			this->weights[k] = floatArray[floatIndex++];
+			this->localX[k] = floatArray[floatIndex++] * scale;
+			this->localY[k] = floatArray[floatIndex++] * scale;
+			this->deformIndices[k] = deformIndex;
+			deformIndex += 2;
+		}
+	}
+
+	this->palette.assign((bonesCount + 1) * PaletteStride, 0.f);
+	this->resultX.assign(this->stride, 0.f);
+	this->resultY.assign(this->stride, 0.f);
+}
+
+bool SF3DSkin::isBuiltFrom(const VerticesData* verticesData, float scale) const
+{
+	return this->verticesData == verticesData && this->scale == scale;
+}
+
+void SF3DSkin::clear()
+{
+	this->verticesData = nullptr;
+	this->vertexCount = 0;
+	this->stride = 0;
+	this->influencesCount = 0;
+	this->bonesCount = 0;
+}
+
+void SF3DSkin::skin(const std::vector<Bone*>& bones, const std::vector<float>& deformVertices)
+{
+	// Last entry stays empty, for unused influences
+	for (std::size_t i = 0; i < this->bonesCount; ++i)
+	{
+		float* entry = &this->palette[i * PaletteStride];
+		const Bone* bone = i < bones.size() ? bones[i] : nullptr;
+		if (bone != nullptr)
+		{
+			const auto& matrix = bone->globalTransformMatrix;
+			entry[0] = matrix.a;
+			entry[1] = matrix.b;
+			entry[2] = matrix.c;
+			entry[3] = matrix.d;
+			entry[4] = matrix.tx;
+			entry[5] = matrix.ty;
+		}
+		else
+		{
+			std::fill(entry, entry + PaletteStride, 0.f);
+		}
+	}
+
+	const float* x = this->localX.data();
+	const float* y = this->localY.data();
+
+	// FFD moves local positions of influences
+	if (!deformVertices.empty())
+	{
+		this->deformedX.resize(this->localX.size());
+		this->deformedY.resize(this->localY.size());
+		for (std::size_t k = 0; k < this->localX.size(); ++k)
+		{
+			const std::int32_t index = this->deformIndices[k];
+			const bool deformed = index >= 0 && static_cast<std::size_t>(index) + 1 < deformVertices.size();
+			this->deformedX[k] = this->localX[k] + (deformed ? deformVertices[index] : 0.f);
+			this->deformedY[k] = this->localY[k] + (deformed ? deformVertices[index + 1] : 0.f);
+		}
+		x = this->deformedX.data();
+		y = this->deformedY.data();
+	}
+
+	if (vectorized)
+	{
+		skinVectorized(x, y);
+	}
+	else
+	{
+		skinScalar(x, y);
+	}
+}
+
+std::size_t SF3DSkin::getVertexCount() const
+{
+	return this->vertexCount;
+}
+
+const float* SF3DSkin::getX() const
+{
+	return this->resultX.data();
+}
+
+const float* SF3DSkin::getY() const
+{
+	return this->resultY.data();
+}
+
+void SF3DSkin::setVectorized(bool vectorized)
+{
+	SF3DSkin::vectorized = vectorized;
+}
+
+bool SF3DSkin::isVectorized()
+{
+	return vectorized;
+}
+
+const char* SF3DSkin::getInstructionSet()
+{
+	#if defined(SF3D_SKIN_AVX2)
+		return "AVX2";
+	#elif defined(SF3D_SKIN_SSE2)
+		return "SSE2";
+	#else
+		return "scalar";
+	#endif
+}
+
+void SF3DSkin::skinScalar(const float* x, const float* y)
+{
+	for (std::size_t i = 0; i < this->vertexCount; ++i)
+	{
+		float xG = 0.f;
+		float yG = 0.f;
+
+		for (std::size_t j = 0; j < this->influencesCount; ++j)
+		{
+			const std::size_t k = j * this->stride + i;
+			const float* matrix = &this->palette[this->boneIndices[k] * PaletteStride];
+			const float weight = this->weights[k];
+
+			xG += (matrix[0] * x[k] + matrix[2] * y[k] + matrix[4]) * weight;
+			yG += (matrix[1] * x[k] + matrix[3] * y[k] + matrix[5]) * weight;
+		}
+
+		this->resultX[i] = xG;
+		this->resultY[i] = yG;
+	}
+}
+
+void SF3DSkin::skinVectorized(const float* x, const float* y)
+{
+	const float* palette = this->palette.data();
+	const std::int32_t* boneIndices = this->boneIndices.data();
+	const float* weights = this->weights.data();
+
+	#if defined(SF3D_SKIN_AVX2)
+		// Bone matrices are gathered straight from palette
+		const __m256i paletteStride = _mm256_set1_epi32(PaletteStride);
+		for (std::size_t i = 0; i < this->stride; i += 8)
+		{
+			__m256 xG = _mm256_setzero_ps();
+			__m256 yG = _mm256_setzero_ps();
+
+			for (std::size_t j = 0; j < this->influencesCount; ++j)
+			{
+				const std::size_t k = j * this->stride + i;
+				const __m256i base = _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(boneIndices + k)), paletteStride);
+
+				const __m256 a = _mm256_i32gather_ps(palette + 0, base, 4);
+				const __m256 b = _mm256_i32gather_ps(palette + 1, base, 4);
+				const __m256 c = _mm256_i32gather_ps(palette + 2, base, 4);
+				const __m256 d = _mm256_i32gather_ps(palette + 3, base, 4);
+				const __m256 tx = _mm256_i32gather_ps(palette + 4, base, 4);
+				const __m256 ty = _mm256_i32gather_ps(palette + 5, base, 4);
+
+				const __m256 xL = _mm256_loadu_ps(x + k);
+				const __m256 yL = _mm256_loadu_ps(y + k);
+				const __m256 weight = _mm256_loadu_ps(weights + k);
+
+				xG = _mm256_add_ps(xG, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(a, xL), _mm256_mul_ps(c, yL)), tx), weight));
+				yG = _mm256_add_ps(yG, _mm256_mul_ps(_mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(b, xL), _mm256_mul_ps(d, yL)), ty), weight));
+			}
+
+			_mm256_storeu_ps(this->resultX.data() + i, xG);
+			_mm256_storeu_ps(this->resultY.data() + i, yG);
+		}
+	#elif defined(SF3D_SKIN_SSE2)
+		// Matrices of 4 vertices are loaded as rows and transposed into columns
+		for (std::size_t i = 0; i < this->stride; i += 4)
+		{
+			__m128 xG = _mm_setzero_ps();
+			__m128 yG = _mm_setzero_ps();
+
+			for (std::size_t j = 0; j < this->influencesCount; ++j)
+			{
+				const std::size_t k = j * this->stride + i;
+				const float* m0 = palette + boneIndices[k + 0] * PaletteStride;
+				const float* m1 = palette + boneIndices[k + 1] * PaletteStride;
+				const float* m2 = palette + boneIndices[k + 2] * PaletteStride;
+				const float* m3 = palette + boneIndices[k + 3] * PaletteStride;
+
+				__m128 a = _mm_loadu_ps(m0);
+				__m128 b = _mm_loadu_ps(m1);
+				__m128 c = _mm_loadu_ps(m2);
+				__m128 d = _mm_loadu_ps(m3);
+				_MM_TRANSPOSE4_PS(a, b, c, d);
+
+				__m128 tx = _mm_loadu_ps(m0 + 4);
+				__m128 ty = _mm_loadu_ps(m1 + 4);
+				__m128 t2 = _mm_loadu_ps(m2 + 4);
+				__m128 t3 = _mm_loadu_ps(m3 + 4);
+				_MM_TRANSPOSE4_PS(tx, ty, t2, t3);
+
+				const __m128 xL = _mm_loadu_ps(x + k);
+				const __m128 yL = _mm_loadu_ps(y + k);
+				const __m128 weight = _mm_loadu_ps(weights + k);
+
+				xG = _mm_add_ps(xG, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(a, xL), _mm_mul_ps(c, yL)), tx), weight));
+				yG = _mm_add_ps(yG, _mm_mul_ps(_mm_add_ps(_mm_add_ps(_mm_mul_ps(b, xL), _mm_mul_ps(d, yL)), ty), weight));
+			}
+
+			_mm_storeu_ps(this->resultX.data() + i, xG);
+			_mm_storeu_ps(this->resultY.data() + i, yG);
+		}
+	#else
+		skinScalar(x, y);
+	#endif
+}
+
+DRAGONBONES_NAMESPACE_END
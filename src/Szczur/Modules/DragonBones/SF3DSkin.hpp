@@ -0,0 +1,89 @@
+/** @file SF3DSkin.hpp
+** @description Skinning of DragonBones meshes, working on few vertices at once.
+**/
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include <dragonBones/DragonBonesHeaders.h>
+
+DRAGONBONES_NAMESPACE_BEGIN
+
+/** @class SF3DSkin
+** Bone weights of mesh flattened into streams once, so each frame is only multiplying and adding
+**/
+class SF3DSkin
+{
+	/* Fields */
+public:
+	/// Vertices processed at once by vector kernel, streams are padded to it
+	static constexpr std::size_t Lanes = 8;
+
+private:
+	static bool vectorized;
+
+	const VerticesData* verticesData = nullptr;
+	float scale = 0.f;
+
+	std::size_t vertexCount = 0;
+	std::size_t stride = 0;
+	std::size_t influencesCount = 0;
+	std::size_t bonesCount = 0;
+
+	// Streams indexed by `influence * stride + vertex`, unused influences point at empty bone with zero weight
+	std::vector<std::int32_t> boneIndices;
+	std::vector<float> weights;
+	std::vector<float> localX;
+	std::vector<float> localY;
+
+	// Index of FFD offset in deform vertices for each influence, -1 for unused
+	std::vector<std::int32_t> deformIndices;
+
+	// Built each frame
+	std::vector<float> palette;
+	std::vector<float> deformedX;
+	std::vector<float> deformedY;
+	std::vector<float> resultX;
+	std::vector<float> resultY;
+
+	/* Operators */
+public:
+	SF3DSkin() = default;
+	~SF3DSkin() = default;
+
+	/* Methods */
+public:
+	/// Flattens weights of mesh, positions are scaled by armature scale
+	void build(const VerticesData& verticesData, std::size_t bonesCount, float scale);
+
+	/// Whether streams were built from given mesh and scale
+	bool isBuiltFrom(const VerticesData* verticesData, float scale) const;
+
+	///
+	void clear();
+
+	/// Calculates positions of all vertices from current bone matrices, missing bones do not move vertices
+	void skin(const std::vector<Bone*>& bones, const std::vector<float>& deformVertices);
+
+	///
+	std::size_t getVertexCount() const;
+
+	/// Skinned positions, valid until next `skin` or `build`
+	const float* getX() const;
+	const float* getY() const;
+
+	/// Vector kernel can be turned off to compare it with scalar one
+	static void setVectorized(bool vectorized);
+	static bool isVectorized();
+
+	/// Name of instruction set used by vector kernel in this build
+	static const char* getInstructionSet();
+
+private:
+	void skinScalar(const float* x, const float* y);
+	void skinVectorized(const float* x, const float* y);
+};
+
+DRAGONBONES_NAMESPACE_END
@@ -5,6 +5,8 @@
 
 #include "SF3DSlot.hpp"
 
+#include <algorithm>
+
 #include <SFML/Graphics.hpp>
 
 #include "SF3DArmatureDisplay.hpp"
@@ -119,9 +121,8 @@ void SF3DSlot::_updateFrame()
 
 				std::vector<sf3d::Vertex> vertices(vertexCount);
 
-				std::vector<std::vector<int>> verticesInTriagles;
-
-				std::vector<uint16_t> vertexIndices(triangleCount * 3);
+				sf3d::VertexArray::Indices_t vertexIndices;
+				vertexIndices.reserve(triangleCount * 3);
 
 				for (std::size_t i = 0, l = vertexCount * 2; i < l; i += 2)
 				{
@@ -157,22 +158,13 @@ void SF3DSlot::_updateFrame()
 					vertexIndices.push_back(intArray[currentVerticesData->offset + (unsigned)BinaryOffset::MeshVertexIndices + i]);
 				}
 
-				_renderDisplay->verticesDisplay.resize(vertexIndices.size());
-
-				verticesInTriagles.resize(vertices.size());
-
-				// sorting
-				for (unsigned int i = 0; i < vertexIndices.size(); i++)
-				{
-					verticesInTriagles[vertexIndices[i]].push_back(i);
-					_renderDisplay->verticesDisplay[i] = vertices[vertexIndices[i]];
-				}
+				// Vertices shared by triangles are stored once and drawn by indices
+				_renderDisplay->verticesDisplay.assign(vertices.data(), vertices.size(), sf3d::PrimitiveType::Triangles);
+				_renderDisplay->verticesDisplay.setIndices(vertexIndices);
 
 				_textureScale = 1.f;
 
 				_renderDisplay->texture = currentTextureData->texture;
-				_renderDisplay->verticesInTriagles = std::move(verticesInTriagles);
-				_renderDisplay->verticesDisplay.setPrimitiveType(sf3d::PrimitiveType::Triangles);
 
 				const auto isSkinned = currentVerticesData->weight != nullptr;
 				if (isSkinned)
@@ -187,7 +179,7 @@ void SF3DSlot::_updateFrame()
 
 				_renderDisplay->texture = currentTextureData->texture;
 				_renderDisplay->verticesDisplay.resize(4);
-				_renderDisplay->verticesInTriagles.resize(0);
+				_renderDisplay->verticesDisplay.clearIndices();
 				_renderDisplay->verticesDisplay.setPrimitiveType(sf3d::PrimitiveType::TriangleFan);
 				
 				// Setup verticles
@@ -243,6 +235,13 @@ void SF3DSlot::_updateFrame()
 
 void SF3DSlot::_updateMesh()
 {
+	// Skipped meshes stay dirty, so they catch up when deformation is enabled again
+	if (!static_cast<SF3DArmatureDisplay*>(_armature->getDisplay())->isMeshDeformEnabled())
+	{
+		_deformVertices->verticesDirty = true;
+		return;
+	}
+
 	const auto& deformVertices = _deformVertices->vertices;
 	const auto& deformBones = _deformVertices->bones;
 	const auto& verticesData = _deformVertices->verticesData;
@@ -253,60 +252,25 @@ void SF3DSlot::_updateMesh()
 	// Weightness
 	if (weightData != nullptr)
 	{
-		const auto data = verticesData->data;
-		const int16_t* intArray = data->intArray;
-		const float* floatArray = data->floatArray;
-
-		const std::size_t vertexCount = intArray[verticesData->offset + (std::size_t)BinaryOffset::MeshVertexCount];
-		const std::size_t weightFloatOffset = intArray[weightData->offset + (std::size_t)BinaryOffset::WeigthFloatOffset];
-
 		const auto scale = _armature->_armatureData->scale; // @warn what with _textureScale?
 
-		std::size_t deformWeightsIndex = (std::size_t)weightFloatOffset;
-		std::size_t deformVertexIndex = 0;
-		std::size_t deformBonesIndex = weightData->offset + (std::size_t)BinaryOffset::WeigthBoneIndices + deformBones.size();
-
-		for (std::size_t i = 0; i < vertexCount; ++i)
+		// Weights are flattened once per mesh, then skinned few vertices at once
+		if (!_skin.isBuiltFrom(verticesData, scale))
 		{
-			float xG = 0.0f;
-			float yG = 0.0f;
-
-			// Calculate new position taking into account bone weights
-			const std::size_t boneCount = intArray[deformBonesIndex++];
-			for (std::size_t j = 0; j < boneCount; ++j)
-			{
-				const std::size_t boneIndex = intArray[deformBonesIndex++];
-				const auto bone = deformBones[boneIndex];
-
-				if (bone != nullptr)
-				{
-					const auto& matrix = bone->globalTransformMatrix;
-
-					const auto weight = floatArray[deformWeightsIndex++];
-					auto xL = floatArray[deformWeightsIndex++] * scale;
-					auto yL = floatArray[deformWeightsIndex++] * scale;
-
-					if (hasFFD)
-					{
-						xL += deformVertices[deformVertexIndex++];
-						yL += deformVertices[deformVertexIndex++];
-					}
-
-					xG += (matrix.a * xL + matrix.c * yL + matrix.tx) * weight;
-					yG += (matrix.b * xL + matrix.d * yL + matrix.ty) * weight;
-				}
-			}
+			_skin.build(*verticesData, deformBones.size(), scale);
+		}
+		_skin.skin(deformBones, deformVertices);
 
-			// Update local verticles positions
-			{
-				auto& verticesDisplay = _renderDisplay->verticesDisplay;
-				const auto& verticesInTriagles = _renderDisplay->verticesInTriagles;
+		// Update local verticles positions
+		const float* xG = _skin.getX();
+		const float* yG = _skin.getY();
+		const float z = static_cast<float>(_zOrder);
+		auto& verticesDisplay = _renderDisplay->verticesDisplay;
+		const std::size_t vertexCount = std::min(_skin.getVertexCount(), verticesDisplay.getSize());
 
-				for (const auto& vert : verticesInTriagles[i])
-				{
-					verticesDisplay[vert].position = { xG, yG,  static_cast<float>(_zOrder) };
-				}
-			}
+		for (std::size_t i = 0; i < vertexCount; ++i)
+		{
+			verticesDisplay[i].position = { xG[i], yG[i], z };
 		}
 	}
 
@@ -318,28 +282,26 @@ void SF3DSlot::_updateMesh()
 		const float* floatArray = data->floatArray;
 
 		const std::size_t vertexCount = intArray[verticesData->offset + (std::size_t)BinaryOffset::MeshVertexCount];
-		const std::size_t vertexOffset = intArray[verticesData->offset + (std::size_t)BinaryOffset::MeshFloatOffset];
+		int vertexOffset = intArray[verticesData->offset + (std::size_t)BinaryOffset::MeshFloatOffset];
+
+		if (vertexOffset < 0)
+		{
+			vertexOffset += 65536;
+		}
 
 		const auto scale = _armature->_armatureData->scale; // @warn what with _textureScale?
 
-		for (std::size_t i = 0, I = vertexCount * 2; i < I; i += 2)
-		{
-			const auto traingleIndex = i / 2;
+		auto& verticesDisplay = _renderDisplay->verticesDisplay;
+		const std::size_t count = std::min(vertexCount, verticesDisplay.getSize());
 
+		for (std::size_t i = 0; i < count; ++i)
+		{
 			// Calculate new position
-			const auto xG = floatArray[vertexOffset + i] * scale + deformVertices[i];
-			const auto yG = floatArray[vertexOffset + i + 1] * scale + deformVertices[i + 1];
+			const auto xG = floatArray[vertexOffset + i * 2] * scale + deformVertices[i * 2];
+			const auto yG = floatArray[vertexOffset + i * 2 + 1] * scale + deformVertices[i * 2 + 1];
 
 			// Update local verticles positions
-			{
-				auto& verticesDisplay = _renderDisplay->verticesDisplay;
-				const auto& verticesInTriagles = _renderDisplay->verticesInTriagles;
-
-				for (const auto& vert : verticesInTriagles[traingleIndex])
-				{
-					verticesDisplay[vert].position = { xG, yG, 0.f };
-				}
-			}
+			verticesDisplay[i].position = { xG, yG, 0.f };
 		}
 	}
 }
@@ -376,6 +338,7 @@ void SF3DSlot::_onClear()
 	Slot::_onClear();
 
 	_textureScale = 1.0f;
+	_skin.clear();
 
 	if (_textureData)
 	{
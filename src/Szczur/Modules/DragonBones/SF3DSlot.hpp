@@ -9,6 +9,7 @@
 #include <dragonBones/DragonBonesHeaders.h>
 
 #include "SF3DDisplay.hpp"
+#include "SF3DSkin.hpp"
 
 DRAGONBONES_NAMESPACE_BEGIN
 
@@ -19,6 +20,7 @@ class SF3DSlot : public Slot
 private:
 	float _textureScale;
 	std::unique_ptr<SF3DDisplay> _renderDisplay;
+	SF3DSkin _skin;
 
 public:
 	virtual void _updateVisible() override;
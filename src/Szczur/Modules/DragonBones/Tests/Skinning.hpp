@@ -0,0 +1,172 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+
+#include "Szczur/Modules/World/World.hpp"
+#include "Szczur/Modules/World/Tests/WorldBenchmark.hpp"
+#include "Szczur/Modules/Window/Window.hpp"
+#include "Szczur/Modules/DragonBones/SF3DSkin.hpp"
+#include "Szczur/Modules/DragonBones/SF3DArmatureDisplay.hpp"
+#include "Szczur/Modules/World/Data/ArmatureDataCache.hpp"
+#include "Szczur/Utility/Time/Clock.hpp"
+#include "Szczur/Utility/Tests.hpp"
+
+struct SkinningBenchmark : public WorldBenchmark
+{
+	static constexpr size_t instancesCount = 50;
+	static constexpr size_t framesCount = 200;
+
+	std::vector<rat::ArmatureComponent*> armatures;
+
+	virtual void SetUp() override
+	{
+		WorldBenchmark::SetUp();
+
+		// Battle scene crowd, meshes of both armatures are skinned
+		for (size_t i = 0; i < instancesCount; ++i) {
+			auto* entity = scene->addRawEntity("single");
+			auto* armature = static_cast<rat::ArmatureComponent*>(entity->addComponent<rat::ArmatureComponent>());
+			armature->setArmature(i % 2 ? "Pig" : "Cedmin");
+			armature->playAnim(i % 2 ? "walk" : "Cedmin_Run_051");
+			armatures.push_back(armature);
+		}
+	}
+
+	virtual void TearDown() override
+	{
+		dragonBones::SF3DSkin::setVectorized(true);
+		dragonBones::SF3DArmatureDisplay::setMerging(true);
+		WorldBenchmark::TearDown();
+	}
+
+	///
+	static void setLod(rat::ArmatureComponent* armature, bool enabled, float hiddenRate)
+	{
+		auto lod = armature->getAnimationLod();
+		lod.enabled = enabled;
+		lod.hiddenRate = hiddenRate;
+		armature->setAnimationLod(lod);
+	}
+
+	/// Time of updating all armatures in milliseconds per frame
+	float measure()
+	{
+		rat::Clock clock;
+		for (size_t frame = 0; frame < framesCount; ++frame) {
+			for (auto* armature : armatures) {
+				armature->update(*scenes, 1.f / 60.f);
+			}
+		}
+		return clock.getElapsedTime().asFSeconds() * 1000.f / framesCount;
+	}
+};
+
+/// Pig and Cedmin animated with scalar and vector skinning kernels
+TEST_F(SkinningBenchmark, Animate)
+{
+	dragonBones::SF3DSkin::setVectorized(false);
+	const float scalarTime = measure();
+
+	dragonBones::SF3DSkin::setVectorized(true);
+	const float vectorTime = measure();
+
+	LOG_INFO("Animation of ", instancesCount, " armatures: scalar ", scalarTime, " ms, ", dragonBones::SF3DSkin::getInstructionSet(), " ", vectorTime, " ms per frame");
+}
+
+/// Draw calls of armatures drawn slot by slot and merged, without batching of render target
+TEST_F(SkinningBenchmark, Draw)
+{
+	sf3d::RenderWindow& window = rat::detail::globalPtr<rat::Window>->getWindow();
+	const bool batchingEnabled = window.isBatchingEnabled();
+	window.setBatchingEnabled(false);
+
+	measure();
+
+	auto drawAll = [&] (bool merging) {
+		dragonBones::SF3DArmatureDisplay::setMerging(merging);
+		window.resetStatistics();
+		rat::Clock clock;
+		for (auto* armature : armatures) {
+			window.draw(*armature);
+		}
+		return std::make_pair(window.getStatistics().drawCalls, clock.getElapsedTime().asFSeconds() * 1000.f);
+	};
+
+	const auto [slotsCalls, slotsTime] = drawAll(false);
+	const auto [mergedCalls, mergedTime] = drawAll(true);
+	window.setBatchingEnabled(batchingEnabled);
+
+	LOG_INFO("Drawing of ", instancesCount, " armatures: per slot ", slotsCalls, " calls ", slotsTime, " ms, merged ", mergedCalls, " calls ", mergedTime, " ms");
+
+	if (mergedCalls > slotsCalls || mergedCalls < instancesCount) {
+		throw std::runtime_error("Each armature should be drawn by few merged calls");
+	}
+}
+
+/// Armatures which are not drawn are frozen or slowed down, frozen ones move on once drawn again
+TEST_F(SkinningBenchmark, Lod)
+{
+	const float fullTime = measure();
+
+	for (auto* armature : armatures) {
+		setLod(armature, true, 0.f);
+	}
+	auto* front = armatures.front();
+	auto* state = front->getArmature()->getAnimation()->getLastAnimationState();
+	const float frozenAt = state->getCurrentTime();
+	const float hiddenTime = measure();
+
+	if (state->getCurrentTime() != frozenAt) {
+		throw std::runtime_error("Hidden armature should not be animated");
+	}
+
+	sf3d::RenderWindow& window = rat::detail::globalPtr<rat::Window>->getWindow();
+	window.draw(*front);
+	front->update(*scenes, 1.f / 60.f);
+
+	if (state->getCurrentTime() == frozenAt) {
+		throw std::runtime_error("Drawn armature should be animated again");
+	}
+
+	// Few updates per second, so first frames are skipped
+	setLod(front, true, 4.f);
+	const float slowedAt = state->getCurrentTime();
+	front->update(*scenes, 1.f / 60.f);
+	if (state->getCurrentTime() != slowedAt) {
+		throw std::runtime_error("Hidden armature should wait for its rate");
+	}
+	for (size_t frame = 0; frame < 20; ++frame) {
+		front->update(*scenes, 1.f / 60.f);
+	}
+	if (state->getCurrentTime() == slowedAt) {
+		throw std::runtime_error("Hidden armature should be animated at its rate");
+	}
+
+	LOG_INFO("Animation of ", instancesCount, " armatures: all ", fullTime, " ms, hidden ", hiddenTime, " ms per frame");
+}
+
+/// Armatures spawned again and display data of same files share one parsed data
+TEST_F(SkinningBenchmark, SharedData)
+{
+	auto& cache = rat::ArmatureDataCache::get();
+	const size_t parsesCount = cache.getParsesCount();
+	const auto* pig = armatures[1]->getArmatureDisplayData();
+
+	for (size_t i = 0; i < 20; ++i) {
+		auto* entity = scene->addRawEntity("single");
+		static_cast<rat::ArmatureComponent*>(entity->addComponent<rat::ArmatureComponent>())->setArmature("Pig");
+	}
+
+	const size_t references = cache.getReferences(pig->getContentKey());
+	{
+		rat::ArmatureDisplayData copy(pig->getFolderPath());
+		if (copy.getContentKey() != pig->getContentKey() || cache.getReferences(pig->getContentKey()) != references + 1) {
+			throw std::runtime_error("Display data of same files should share cached data");
+		}
+	}
+
+	if (cache.getParsesCount() != parsesCount || cache.getReferences(pig->getContentKey()) != references) {
+		throw std::runtime_error("Pig should be parsed only once");
+	}
+}
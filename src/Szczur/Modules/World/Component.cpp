@@ -1,5 +1,7 @@
 #include "Entity.hpp"
 
+#include <glm/common.hpp>
+
 #include "ScenesManager.hpp"
 
 namespace rat
@@ -79,4 +81,20 @@ void Component::renderHeader(ScenesManager& scenes, Entity* object) {
 
 }
 
+bool Component::getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const
+{
+	return false;
+}
+
+void Component::_transformBounds(const glm::mat4& transform, const glm::vec4& bounds, glm::vec3& boundsMin, glm::vec3& boundsMax)
+{
+	boundsMin = boundsMax = glm::vec3(transform * glm::vec4(bounds.x, bounds.y, 0.f, 1.f));
+	for (const glm::vec2& corner : { glm::vec2{ bounds.x + bounds.z, bounds.y }, glm::vec2{ bounds.x, bounds.y + bounds.w }, glm::vec2{ bounds.x + bounds.z, bounds.y + bounds.w } })
+	{
+		const glm::vec3 point = glm::vec3(transform * glm::vec4(corner, 0.f, 1.f));
+		boundsMin = glm::min(boundsMin, point);
+		boundsMax = glm::max(boundsMax, point);
+	}
+}
+
 }
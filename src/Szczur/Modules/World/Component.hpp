@@ -9,7 +9,12 @@ using Json = nlohmann::json;
 
 #include <imgui.h>
 
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
 #include "UniqueID.hpp"
+#include "ComponentPool.hpp"
 #include "Szczur/Utility/Convert/Hash.hpp"
 
 
@@ -29,6 +34,12 @@ public:
 		Drawable = 1
 	};
 
+	/// Number of bits used by Feature_e
+	static constexpr size_t FeaturesCount = 1;
+
+	/// Update touches only own component and entity, so it may run on job system workers. Types override it
+	static constexpr bool ThreadSafeUpdate = false;
+
 	///
 	Component(Entity* parent, Hash64_t id, const std::string& name, size_t features = 0);
 
@@ -86,7 +97,14 @@ public:
 	///
 	virtual void renderHeader(ScenesManager& scenes, Entity* object);
 
+	/// Bounds of drawn geometry in world space, false if they are unknown and entity is never culled
+	virtual bool getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+
 protected:
+
+	/// Box containing local rectangle { left, top, width, height } transformed by matrix
+	static void _transformBounds(const glm::mat4& transform, const glm::vec4& bounds, glm::vec3& boundsMin, glm::vec3& boundsMax);
+
 	template<typename T>
 	void drawOriginSetter(std::function<void(T*, int, int)> func)
 	{
@@ -0,0 +1,164 @@
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+namespace rat
+{
+
+/// Contiguous storage for all components of one type, addresses stay valid until component is deleted
+template <typename T>
+class ComponentPool
+{
+public:
+
+	/// Components in one block of memory
+	static constexpr size_t ChunkSize = 256;
+
+	///
+	ComponentPool() = default;
+
+	// Non-copyable
+	ComponentPool(const ComponentPool&) = delete;
+	ComponentPool& operator = (const ComponentPool&) = delete;
+
+	///
+	static ComponentPool& get()
+	{
+		static ComponentPool pool;
+		return pool;
+	}
+
+	/// Memory for one component, lowest free slots are used first to keep components dense
+	void* allocate()
+	{
+		if (_free.empty())
+		{
+			_addChunk();
+		}
+
+		// Free indices are kept as min-heap
+		std::pop_heap(_free.begin(), _free.end(), std::greater<>{});
+		const size_t index = _free.back();
+		_free.pop_back();
+
+		auto& chunk = *_chunks[index / ChunkSize];
+		chunk.alive.set(index % ChunkSize);
+		++_size;
+
+		auto& slot = chunk.slots[index % ChunkSize];
+		slot.index = index;
+		return &slot.storage;
+	}
+
+	///
+	void deallocate(void* pointer)
+	{
+		// Storage is first member of slot, so both share address
+		const size_t index = static_cast<const Slot*>(pointer)->index;
+
+		_chunks[index / ChunkSize]->alive.reset(index % ChunkSize);
+		_free.push_back(index);
+		std::push_heap(_free.begin(), _free.end(), std::greater<>{});
+		--_size;
+	}
+
+	/// Calls function for every living component in memory order, components added while iterating may be skipped
+	template <typename F>
+	void forEach(F&& function)
+	{
+		for (size_t i = 0; i < _chunks.size(); ++i)
+		{
+			for (size_t j = 0; j < ChunkSize; ++j)
+			{
+				// Chunk is looked up again, function may add chunks
+				auto& chunk = *_chunks[i];
+				if (chunk.alive.test(j))
+				{
+					function(*std::launder(reinterpret_cast<T*>(&chunk.slots[j].storage)));
+				}
+			}
+		}
+	}
+
+	/// Number of living components
+	size_t getSize() const
+	{
+		return _size;
+	}
+
+	/// Number of components which fit without allocating
+	size_t getCapacity() const
+	{
+		return _chunks.size() * ChunkSize;
+	}
+
+private:
+
+	struct Slot
+	{
+		std::aligned_storage_t<sizeof(T), alignof(T)> storage;
+		size_t index;
+	};
+
+	struct Chunk
+	{
+		Slot slots[ChunkSize];
+		std::bitset<ChunkSize> alive;
+	};
+
+	///
+	void _addChunk()
+	{
+		const size_t first = _chunks.size() * ChunkSize;
+		_chunks.push_back(std::make_unique<Chunk>());
+
+		// Chunk is added only when nothing is free, ascending indices already form min-heap
+		for (size_t i = 0; i < ChunkSize; ++i)
+		{
+			_free.push_back(first + i);
+		}
+	}
+
+	std::vector<std::unique_ptr<Chunk>> _chunks;
+	std::vector<size_t> _free;
+	size_t _size = 0;
+
+};
+
+/// Base making `new T` take memory from `ComponentPool<T>`, used from main thread only
+template <typename T>
+struct PooledComponent
+{
+	///
+	static void* operator new(size_t size)
+	{
+		// Derived types have other size and use global heap
+		if (size != sizeof(T))
+		{
+			return ::operator new(size);
+		}
+
+		return ComponentPool<T>::get().allocate();
+	}
+
+	///
+	static void operator delete(void* pointer, size_t size)
+	{
+		if (size != sizeof(T))
+		{
+			::operator delete(pointer);
+			return;
+		}
+
+		ComponentPool<T>::get().deallocate(pointer);
+	}
+};
+
+}
@@ -16,6 +16,7 @@
 #include "Components/AudioComponent.hpp"
 
 #include <memory>
+#include <type_traits>
 
 namespace rat
 {
@@ -24,8 +25,78 @@ namespace rat
 class Entity;
 template<class T> class ScriptClass;
 
+/// List of component types, position in list is slot of component in entity
+template <typename... Ts>
+struct ComponentsList
+{
+	static constexpr size_t Count = sizeof...(Ts);
+
+	///
+	template <typename T>
+	static constexpr size_t getSlot()
+	{
+		constexpr bool matches[] = { std::is_same_v<T, Ts>... };
+
+		for (size_t i = 0; i < Count; ++i)
+		{
+			if (matches[i]) return i;
+		}
+
+		return Count;
+	}
+};
+
 struct ComponentTraits
 {
+	/// Every component type has to be listed here to be stored in entity
+	using Components_t = ComponentsList<
+		BaseComponent,
+		ColliderComponent,
+		SpriteComponent,
+		AnimatedSpriteComponent,
+		ArmatureComponent,
+		CameraComponent,
+		ScriptableComponent,
+		InteractableComponent,
+		TriggerComponent,
+		TraceComponent,
+		PointLightComponent,
+		AudioComponent
+	>;
+
+	///
+	static constexpr size_t ComponentsCount = Components_t::Count;
+
+	/// Slot of component in entity, known at compile time
+	template <typename T>
+	static constexpr size_t getSlotFromType()
+	{
+		constexpr size_t slot = Components_t::getSlot<T>();
+		static_assert(slot < ComponentsCount, "Component type is not registered in ComponentTraits::Components_t");
+		return slot;
+	}
+
+	/// Slot of component in entity, ComponentsCount for unknown identifiers
+	static size_t getSlotFromIdentifier(Hash64_t id)
+	{
+		switch (id)
+		{
+			case fnv1a_64("BaseComponent"): return getSlotFromType<BaseComponent>();
+			case fnv1a_64("ColliderComponent"): return getSlotFromType<ColliderComponent>();
+			case fnv1a_64("SpriteComponent"): return getSlotFromType<SpriteComponent>();
+			case fnv1a_64("AnimatedSpriteComponent"): return getSlotFromType<AnimatedSpriteComponent>();
+			case fnv1a_64("ArmatureComponent"): return getSlotFromType<ArmatureComponent>();
+			case fnv1a_64("CameraComponent"): return getSlotFromType<CameraComponent>();
+			case fnv1a_64("ScriptableComponent"): return getSlotFromType<ScriptableComponent>();
+			case fnv1a_64("InteractableComponent"): return getSlotFromType<InteractableComponent>();
+			case fnv1a_64("TriggerComponent"): return getSlotFromType<TriggerComponent>();
+			case fnv1a_64("TraceComponent"): return getSlotFromType<TraceComponent>();
+			case fnv1a_64("PointLightComponent"): return getSlotFromType<PointLightComponent>();
+			case fnv1a_64("AudioComponent"): return getSlotFromType<AudioComponent>();
+			default: return ComponentsCount;
+		}
+	}
+
 	///
 	static std::unique_ptr<Component> createFromComponentID(Entity* parent, Hash64_t id)
 	{
@@ -30,7 +30,7 @@ namespace rat {
 
 	void AnimatedSpriteComponent::setSpriteDisplayData(SpriteDisplayData* spriteDisplayData)
 	{
-		_spriteDisplayData = spriteDisplayData;
+		_spriteDisplayData.reset(spriteDisplayData);
 	}
 
 	void AnimatedSpriteComponent::setTexture(const std::string& texturePath)
@@ -143,6 +143,11 @@ namespace rat {
 	void AnimatedSpriteComponent::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 	{
 		if(_spriteDisplayData && _isPlaying)
+		{
+			_spriteDisplayData->markUsed();
+		}
+
+		if(_spriteDisplayData && _spriteDisplayData->isLoaded() && _isPlaying)
 		{
 			states.transform *= getEntity()->getTransform();
 			states.texture = &_spriteDisplayData->getTexture();
@@ -151,29 +156,40 @@ namespace rat {
 		}
 	}
 
+	bool AnimatedSpriteComponent::getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const
+	{
+		if (!_spriteDisplayData)
+			return false;
+
+		_transformBounds(getEntity()->getTransform().getMatrix(), _vertices.getBounds(), boundsMin, boundsMax);
+		return true;
+	}
+
 	void AnimatedSpriteComponent::setTextureRect(const sf::FloatRect& rect)
 	{
-		auto texSize = _spriteDisplayData->getTexture().getSize();
+		// Texture coordinates may point into atlas page
+		const auto min = _spriteDisplayData->getTexCoord({ rect.left, rect.top });
+		const auto max = _spriteDisplayData->getTexCoord({ rect.left + rect.width, rect.top + rect.height });
 
 		_vertices[0] = {
 			{ 0.f, 0.f, 0.f },
 			{ 1.f, 1.f, 1.f, 1.f },
-			{ rect.left / texSize.x, rect.top / texSize.y }
+			{ min.x, min.y }
 		};
 		_vertices[1] = {
 			{ rect.width, 0.f, 0.f },
 			{ 1.f, 1.f, 1.f, 1.f },
-			{ (rect.left + rect.width) / texSize.x, rect.top / texSize.y }
+			{ max.x, min.y }
 		};
 		_vertices[2] = {
 			{ rect.width, -rect.height, 0.f },
 			{ 1.f, 1.f, 1.f, 1.f },
-			{ (rect.left + rect.width) / texSize.x, (rect.top + rect.height) / texSize.y }
+			{ max.x, max.y }
 		};
 		_vertices[3] = {
 			{ 0.f, -rect.height, 0.f },
 			{ 1.f, 1.f, 1.f, 1.f },
-			{ rect.left / texSize.x, (rect.top + rect.height) / texSize.y }
+			{ min.x, max.y }
 		};
 	}
 
@@ -234,7 +250,7 @@ namespace rat {
 				{
 					if (_autoUpdateFrameSize)
 					{
-						auto size = _spriteDisplayData->getTexture().getSize();
+						auto size = _spriteDisplayData->getSize();
 						_frameSize = { size.x / _columns,  size.y / _rows };
 					}
 
@@ -251,7 +267,7 @@ namespace rat {
 				{
 					if (_autoUpdateFrameSize)
 					{
-						auto size = _spriteDisplayData->getTexture().getSize();
+						auto size = _spriteDisplayData->getSize();
 						_frameSize = { size.x / _columns,  size.y / _rows };
 					}
 
@@ -300,7 +316,7 @@ namespace rat {
 		object.set("setTexture", &AnimatedSpriteComponent::setTexture);
 		object.set("setTextureData", &AnimatedSpriteComponent::setSpriteDisplayData);
 		object.set("getTextureData", &AnimatedSpriteComponent::getSpriteDisplayData);
-		object.set("getTextureSize", [](AnimatedSpriteComponent& comp){return glm::vec2(comp._spriteDisplayData->getTexture().getSize());});
+		object.set("getTextureSize", [](AnimatedSpriteComponent& comp){return glm::vec2(comp._spriteDisplayData->getSize());});
 
 		object.set("getEntity", sol::resolve<Entity*()>(&Component::getEntity));
 
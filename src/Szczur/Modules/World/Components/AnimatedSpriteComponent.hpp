@@ -16,7 +16,7 @@ class Entity;
 class Script;
 template<class T> class ScriptClass;
 
-class AnimatedSpriteComponent : public sf3d::Drawable, public Component
+class AnimatedSpriteComponent : public sf3d::Drawable, public Component, public PooledComponent<AnimatedSpriteComponent>
 {
 public:
 	enum SpriteSheet
@@ -26,6 +26,9 @@ public:
 	};
 
 public:
+	/// Frame stepping changes only own vertices, they are uploaded when drawn
+	static constexpr bool ThreadSafeUpdate = true;
+
 	///
 	AnimatedSpriteComponent(Entity* parent);
 
@@ -74,6 +77,9 @@ public:
 	///
 	virtual void draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const override;
 
+	/// Current frame rectangle
+	virtual bool getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const override;
+
 	///
 	virtual void setTextureRect(const sf::FloatRect& rect);
 
@@ -128,7 +134,7 @@ private:
 	void setOrigin(int vertical = 0, int horizontal = 0);
 
 private:
-	SpriteDisplayData* _spriteDisplayData = nullptr;
+	SpriteDisplayDataHandle _spriteDisplayData;
 	sf3d::VertexArray _vertices{ 4 };
 
 	bool _isPlaying = true;
@@ -1,6 +1,9 @@
 #include "ArmatureComponent.hpp"
 
 #include <experimental/filesystem>
+#include <limits>
+
+#include <glm/geometric.hpp>
 
 #include "Szczur/Modules/DragonBones/SF3DFactory.hpp"
 
@@ -30,6 +33,7 @@ ArmatureComponent::~ArmatureComponent()
 void ArmatureComponent::setArmatureDisplayData(ArmatureDisplayData* armatureDisplayData, bool deleteOld)
 {
 	_armatureDisplayData = armatureDisplayData;
+	_localBoundsValid = false;
 	if (armatureDisplayData)
 	{
 		auto dbFactory = dragonBones::SF3DFactory::get();
@@ -37,7 +41,8 @@ void ArmatureComponent::setArmatureDisplayData(ArmatureDisplayData* armatureDisp
 		if (_armature && deleteOld)
 			delete _armature;
 
-		_armature = dbFactory->buildArmatureDisplay(armatureDisplayData->getName());
+		const auto& dataName = armatureDisplayData->getDataName();
+		_armature = dbFactory->buildArmatureDisplay(armatureDisplayData->getName(), dataName, "", dataName);
 	}
 	else if (_armature)
 	{
@@ -137,6 +142,16 @@ const void* ArmatureComponent::getFeature(Component::Feature_e feature) const
 void ArmatureComponent::loadFromConfig(Json& config)
 {
 	Component::loadFromConfig(config);
+
+	if (auto lod = config.find("animationLod"); lod != config.end())
+	{
+		_animationLod.enabled = (*lod)["enabled"];
+		_animationLod.reducedDistance = (*lod)["reducedDistance"];
+		_animationLod.meshDistance = (*lod)["meshDistance"];
+		_animationLod.reducedRate = (*lod)["reducedRate"];
+		_animationLod.hiddenRate = (*lod)["hiddenRate"];
+	}
+
 	auto name = mapUtf8ToWindows1250(config["armatureDisplayData"].get<std::string>());
 	if (name != "")
 	{
@@ -158,6 +173,13 @@ void ArmatureComponent::saveToConfig(Json& config) const
 	Component::saveToConfig(config);
 	config["armatureDisplayData"] = _armatureDisplayData ? mapWindows1250ToUtf8(_armatureDisplayData->getName()) : "";
 
+	auto& lod = config["animationLod"];
+	lod["enabled"] = _animationLod.enabled;
+	lod["reducedDistance"] = _animationLod.reducedDistance;
+	lod["meshDistance"] = _animationLod.meshDistance;
+	lod["reducedRate"] = _animationLod.reducedRate;
+	lod["hiddenRate"] = _animationLod.hiddenRate;
+
 	if (_armature)
 	{
 		config["speed"] = _armature->getAnimation()->timeScale;
@@ -173,7 +195,26 @@ void ArmatureComponent::update(ScenesManager& scenes, float deltaTime)
 {
 	if (_armature)
 	{
-		_armature->getArmature()->advanceTime(deltaTime);
+		bool deformMeshes = true;
+		const float rate = _getAnimationRate(deformMeshes);
+		_drawnSinceUpdate = false;
+
+		// Frozen armatures resume from their pose, time they were hidden is not caught up
+		if (rate == 0.f)
+		{
+			return;
+		}
+
+		_pendingTime += deltaTime;
+
+		if (rate > 0.f && _pendingTime < 1.f / rate)
+		{
+			return;
+		}
+
+		_armature->setMeshDeformEnabled(deformMeshes);
+		_armature->getArmature()->advanceTime(_pendingTime);
+		_pendingTime = 0.f;
 
 		if (_onceAnimStatus == OnceAnimStatus::IsAboutToPlay)
 		{
@@ -206,9 +247,58 @@ void ArmatureComponent::draw(sf3d::RenderTarget& target, sf3d::RenderStates stat
 {
 	if (_armature)
 	{
+		_drawnSinceUpdate = true;
+
 		states.transform *= getEntity()->getTransform();
 		_armature->draw(target, states);
+
+		// Slots are walked anyway when drawn, so culling does not have to do it every frame
+		const auto box = _armature->getBoundingBox();
+		_localBounds = { box.left, box.top, box.width, box.height };
+		_localBoundsValid = box.width > 0.f && box.height > 0.f;
+	}
+}
+
+float ArmatureComponent::_getAnimationRate(bool& deformMeshes)
+{
+	deformMeshes = true;
+
+	if (!_animationLod.enabled)
+	{
+		return -1.f;
 	}
+
+	// Culled or hidden armatures were not drawn since last update
+	if (!_drawnSinceUpdate)
+	{
+		return _animationLod.hiddenRate;
+	}
+
+	Entity* camera = getEntity()->getScene()->getCamera();
+	if (!camera)
+	{
+		return -1.f;
+	}
+
+	const float distance = glm::distance(camera->getPosition(), getEntity()->getPosition());
+	deformMeshes = distance < _animationLod.meshDistance;
+
+	return distance < _animationLod.reducedDistance ? -1.f : _animationLod.reducedRate;
+}
+
+bool ArmatureComponent::getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const
+{
+	if (!_armature || !_localBoundsValid)
+	{
+		return false;
+	}
+
+	// Animation keeps playing while culled, so bones may reach out of last drawn pose
+	const glm::vec2 margin = glm::vec2(_localBounds.z, _localBounds.w) * 0.25f;
+	const glm::vec4 bounds { _localBounds.x - margin.x, _localBounds.y - margin.y, _localBounds.z + margin.x * 2.f, _localBounds.w + margin.y * 2.f };
+
+	_transformBounds(getEntity()->getTransform().getMatrix(), bounds, boundsMin, boundsMax);
+	return true;
 }
 
 void ArmatureComponent::loadArmature()
@@ -361,6 +451,16 @@ void ArmatureComponent::setSlotDisplay(const std::string& slotName, const std::s
 	}
 }
 
+void ArmatureComponent::setAnimationLod(const AnimationLod& lod)
+{
+	_animationLod = lod;
+}
+
+const ArmatureComponent::AnimationLod& ArmatureComponent::getAnimationLod() const
+{
+	return _animationLod;
+}
+
 bool ArmatureComponent::isPlaying()
 {
 	if (_armature)
@@ -475,6 +575,17 @@ void ArmatureComponent::renderHeader(ScenesManager& scenes, Entity* object)
 
 			ImGui::DragFloat<ImGui::CopyPaste>("Animation speed##armature_component", arm->getAnimation()->timeScale, 0.01f);
 		}
+
+		// Level of detail
+		if (ImGui::TreeNode("Animation LOD##armature_component"))
+		{
+			ImGui::Checkbox("Enabled##armature_component", &_animationLod.enabled);
+			ImGui::DragFloat<ImGui::CopyPaste>("Reduced rate distance##armature_component", _animationLod.reducedDistance, 10.f, 0.f, std::numeric_limits<float>::max());
+			ImGui::DragFloat<ImGui::CopyPaste>("Frozen meshes distance##armature_component", _animationLod.meshDistance, 10.f, 0.f, std::numeric_limits<float>::max());
+			ImGui::DragFloat<ImGui::CopyPaste>("Reduced rate (updates/s)##armature_component", _animationLod.reducedRate, 0.5f, 0.f, 60.f);
+			ImGui::DragFloat<ImGui::CopyPaste>("Hidden rate (updates/s)##armature_component", _animationLod.hiddenRate, 0.5f, 0.f, 60.f);
+			ImGui::TreePop();
+		}
 	}
 }
 
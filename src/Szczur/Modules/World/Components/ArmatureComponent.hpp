@@ -21,7 +21,7 @@ namespace rat
 class Entity;
 template<class T> class ScriptClass;
 
-class ArmatureComponent : public Component, public sf3d::Drawable
+class ArmatureComponent : public Component, public sf3d::Drawable, public PooledComponent<ArmatureComponent>
 {
 private:
 	enum OnceAnimStatus
@@ -33,6 +33,25 @@ private:
 
 public:
 
+	/// Animation level of detail, distances are measured from current camera of scene
+	struct AnimationLod
+	{
+		/// Off by default, scenes opt in for crowds of armatures
+		bool enabled = false;
+
+		/// Visible armatures further than it are updated at reduced rate
+		float reducedDistance = 2000.f;
+
+		/// Meshes of armatures further than it keep their last pose
+		float meshDistance = 4000.f;
+
+		/// Updates per second of distant armatures
+		float reducedRate = 15.f;
+
+		/// Updates per second of armatures not drawn last frame, zero freezes them until they are drawn again
+		float hiddenRate = 4.f;
+	};
+
 // Constructors
 
 	///
@@ -107,6 +126,12 @@ public:
 	///
 	void setSlotDisplay(const std::string& slotName, const std::string& displayName);
 
+	///
+	void setAnimationLod(const AnimationLod& lod);
+
+	///
+	const AnimationLod& getAnimationLod() const;
+
 	///
 	bool isPlaying();
 	
@@ -126,6 +151,9 @@ public:
 	///
 	void draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const override;
 
+	/// Uses bounds from last time armature was drawn, enlarged for animation played while culled
+	virtual bool getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const override;
+
 	///
 	virtual void renderHeader(ScenesManager& scenes, Entity* object) override;
 
@@ -134,6 +162,9 @@ private:
 	// @horizontal: -1 top, 0 center, 1 bottom
 	void setOrigin(int vertical = 0, int horizontal = 0);
 
+	/// Updates per second for current camera distance and visibility, negative means every frame
+	float _getAnimationRate(bool& deformMeshes);
+
 private:
 	dragonBones::SF3DArmatureDisplay* _armature = nullptr;
 	ArmatureDisplayData* _armatureDisplayData = nullptr;
@@ -149,6 +180,16 @@ private:
 	float _lastAnimationSpeed = 1.f;
 
 	std::string _lastPlayingAnimation;
+
+	AnimationLod _animationLod;
+
+	// Time not yet passed to armature, skipped updates catch up at once
+	float _pendingTime = 0.f;
+	mutable bool _drawnSinceUpdate = true;
+
+	// Local bounds as { left, top, width, height }, refreshed when drawn
+	mutable glm::vec4 _localBounds;
+	mutable bool _localBoundsValid = false;
 };
 
 }
@@ -15,7 +15,7 @@ class Script;
 class Listener;
 template<class T> class ScriptClass;
 
-class CameraComponent : public Component, public sf3d::Camera {
+class CameraComponent : public Component, public sf3d::Camera, public PooledComponent<CameraComponent> {
 public:
 
     ///
@@ -1,5 +1,7 @@
 #include "ColliderComponent.hpp"
 
+#include <algorithm>
+
 #include <imgui.h>
 
 #include "Szczur/Utility/ImGuiTweaks.hpp"
@@ -21,6 +23,28 @@ std::unique_ptr<Component> ColliderComponent::copy(Entity* newParent) const
 	return ptr;
 }
 
+SpatialHash::Rect_t ColliderComponent::getBounds() const
+{
+	const glm::vec3 position = getEntity()->getPosition();
+
+	glm::vec2 halfSize { 0.f, 0.f };
+	if (_boxCollider)
+	{
+		halfSize = glm::max(halfSize, _boxSize / 2.f);
+	}
+	if (_circleCollider)
+	{
+		halfSize = glm::max(halfSize, glm::vec2(_circleRadius));
+	}
+
+	return { position.x - halfSize.x, position.z - halfSize.y, position.x + halfSize.x, position.z + halfSize.y };
+}
+
+void ColliderComponent::updateSpatialHash()
+{
+	_spatialHashHandle.update(getEntity()->getScene()->getSpatialHash(), this, getBounds(), SpatialHash::Colliders);
+}
+
 void ColliderComponent::loadFromConfig(Json& config)
 {
 	Component::loadFromConfig(config);
@@ -145,7 +169,10 @@ void ColliderComponent::move(float x, float y, float z)
 				if (thisRectX.intersects(entityRect))
 				{
 					if (comp->isDynamic())
+					{
 						entity->move({ velocity.x, 0, 0 }); // move the other
+						comp->updateSpatialHash();
+					}
 					else
 						velocity.x = 0.f; // stop
 				}
@@ -154,7 +181,10 @@ void ColliderComponent::move(float x, float y, float z)
 				if (thisRectZ.intersects(entityRect))
 				{
 					if (comp->isDynamic())
+					{
 						entity->move({ 0, 0, velocity.z }); // move the other
+						comp->updateSpatialHash();
+					}
 					else
 						velocity.z = 0.f; // stop
 				}
@@ -180,6 +210,7 @@ void ColliderComponent::move(float x, float y, float z)
 					{
 						// move the other
 						entity->move({ -cos(angle) * (radius - distance), 0.f, -sin(angle) * (radius - distance) });
+						comp->updateSpatialHash();
 					}
 					else
 					{
@@ -192,16 +223,29 @@ void ColliderComponent::move(float x, float y, float z)
 		}
 	};
 
-	// scan every entity on path
-	auto& entities = this->getEntity()->getScene()->getEntities("path");
-	for (auto& entity : entities)
+	// Only colliders near both positions may collide
+	auto* scene = getEntity()->getScene();
+	auto* player = scene->getPlayer();
+	auto area = getBounds();
+	area.x += std::min(x, 0.f);
+	area.y += std::min(z, 0.f);
+	area.z += std::max(x, 0.f);
+	area.w += std::max(z, 0.f);
+
+	// Copied, pushed colliders are moved in spatial hash while checking
+	for (auto* component : scene->getSpatialHash().queryAABB(area, SpatialHash::Colliders))
 	{
-		collisionCheck(entity.get());
-	}
+		auto* entity = component->getEntity();
 
-	collisionCheck(getEntity()->getScene()->getPlayer());
+		// Entities on path and player collide, like before broadphase
+		if (entity == player || entity->getGroup() == "path")
+		{
+			collisionCheck(entity);
+		}
+	}
 
 	getEntity()->move(velocity);
+	updateSpatialHash();
 }
 
 sf::FloatRect ColliderComponent::_getRect(const glm::vec3& pos, const glm::vec2& size)
@@ -1,6 +1,7 @@
 #pragma once
 
 #include "Szczur/Modules/World/Component.hpp"
+#include "Szczur/Modules/World/SpatialHash.hpp"
 #include "Szczur/Modules/Script/Script.hpp"
 
 #include "Szczur/Utility/SFML3D/RenderTarget.hpp"
@@ -10,7 +11,7 @@
 namespace rat
 {
 
-class ColliderComponent : public Component
+class ColliderComponent : public Component, public PooledComponent<ColliderComponent>
 {
 public:
 	///
@@ -79,6 +80,12 @@ public:
 	///
 	void setDynamic(bool dynamic) { _isDynamic = dynamic; }
 
+	/// Box and circle around entity on XZ plane
+	SpatialHash::Rect_t getBounds() const;
+
+	/// Moves collider in spatial hash of its scene, called each frame by scene and after moves
+	void updateSpatialHash();
+
 private:
 	///
 	static sf::FloatRect _getRect(const glm::vec3& pos, const glm::vec2& size);
@@ -91,6 +98,8 @@ private:
 
 	bool _boxCollider = false;
 	glm::vec2 _boxSize = { 200.f, 200.f };
+
+	SpatialHashHandle _spatialHashHandle;
 };
 
 }
@@ -91,14 +91,12 @@ namespace rat {
 		}
 	}
 
-	void InteractableComponent::update(ScenesManager& scenes, float deltaTime) {
-		auto* player = getEntity()->getScene()->getPlayer();
-		if(player == nullptr) return;
-
-		if(_input.isReleased(Keyboard::LShift)) {
-			if(checkForInteraction(player->getPosition())) {
-				callback();
-			}
-		}
+	SpatialHash::Rect_t InteractableComponent::getBounds() const {
+		auto position = getEntity()->getPosition();
+		return { position.x - _distance, position.z - _distance, position.x + _distance, position.z + _distance };
+	}
+
+	void InteractableComponent::updateSpatialHash() {
+		_spatialHashHandle.update(getEntity()->getScene()->getSpatialHash(), this, getBounds(), SpatialHash::Interactables);
 	}
 }
@@ -13,11 +13,12 @@ namespace rat {
     template<class T> class ScriptClass;
 }
 #include "../Component.hpp"
+#include "../SpatialHash.hpp"
 
 namespace rat
 {
 
-class InteractableComponent : public Component {
+class InteractableComponent : public Component, public PooledComponent<InteractableComponent> {
 public:
 
     ///
@@ -56,8 +57,11 @@ public:
     ///
     virtual void renderHeader(ScenesManager& scenes, Entity* object) override;
 
-    ///
-    void update(ScenesManager& scenes, float deltaTime);
+    /// Circle of interaction on XZ plane
+    SpatialHash::Rect_t getBounds() const;
+
+    /// Moves interaction circle in spatial hash of its scene, called each frame by scene
+    void updateSpatialHash();
 
 private:
 
@@ -65,6 +69,8 @@ private:
     InputManager& _input;
     float _distance{50.f};
     float _height{0.f};
+
+    SpatialHashHandle _spatialHashHandle;
 };
 
 }
@@ -7,6 +7,7 @@
 
 #include "Szczur/Utility/Convert/Windows1250.hpp"
 #include "Szczur/Modules/Script/Script.hpp"
+#include "Szczur/Utility/Profiler.hpp"
 
 #ifdef OS_WINDOWS
 #include <shellapi.h>
@@ -26,12 +27,14 @@ namespace rat {
 	void ScriptableComponent::update(ScenesManager& scenes, float deltaTime) {
 		if(_inited) {
 			if(_updateCallback.valid()) {
+				PROFILE_SCOPE("Lua onUpdate");
 				_updateCallback(getEntity(), deltaTime);
 			}      
 		}
 		else {      
 			_inited = true;
 			if(_initCallback.valid()) {
+				PROFILE_SCOPE("Lua onInit");
 				_initCallback(getEntity());
 			}
 		}
@@ -39,6 +42,7 @@ namespace rat {
 
 	void ScriptableComponent::sceneChanged() {		
 		if(_sceneChangeCallback.valid()) {
+			PROFILE_SCOPE("Lua onChangeScene");
 			_sceneChangeCallback(getEntity());
 		}
 	}
@@ -80,6 +84,7 @@ namespace rat {
 	void ScriptableComponent::runScript(const std::string& path) {
 		try {
 			if(path != "") {
+				PROFILE_SCOPE("Lua script");
 				auto& script = *detail::globalPtr<Script>;
 
 				script.get()["THIS"] = getEntity();
@@ -13,7 +13,7 @@ namespace rat {
 namespace rat
 {
 
-class ScriptableComponent : public Component {
+class ScriptableComponent : public Component, public PooledComponent<ScriptableComponent> {
 public:
 
 // Constructors
@@ -31,7 +31,7 @@ namespace rat {
 	///
 	void SpriteComponent::setSpriteDisplayData(SpriteDisplayData* spriteDisplayData)
 	{
-		_spriteDisplayData = spriteDisplayData;
+		_spriteDisplayData.reset(spriteDisplayData);
 	}
 
 	void SpriteComponent::setTexture(const std::string& texturePath)
@@ -111,12 +111,20 @@ namespace rat {
 	void SpriteComponent::update(ScenesManager& scenes, float deltaTime)
 	{
 		if (_parallax) {
-			auto camera = getEntity()->getScene()->getCamera();
+			// Camera is resolved by scene before passes, lookup could write it from many jobs
+			const Scene* scene = getEntity()->getScene();
 
-			_parallexedPos = _parallaxValue * camera->getPosition().x;
+			if (const Entity* camera = scene->getCurrentCamera()) {
+				_parallexedPos = _parallaxValue * camera->getPosition().x;
+			}
 		}
 	}
 
+	float SpriteComponent::getParallaxOffset() const
+	{
+		return _parallexedPos;
+	}
+
 	///
 	void SpriteComponent::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 	{
@@ -131,6 +139,20 @@ namespace rat {
 		}
 	}
 
+	bool SpriteComponent::getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const
+	{
+		if (!_spriteDisplayData)
+			return false;
+
+		// Same transform as in `draw`, sprite goes down from origin
+		sf3d::Transform transform = getEntity()->getTransform();
+		transform.translate(_parallexedPos, 0.f, 0.f);
+
+		const glm::vec2 size = _spriteDisplayData->getSize();
+		_transformBounds(transform.getMatrix(), { 0.f, -size.y, size.x, size.y }, boundsMin, boundsMax);
+		return true;
+	}
+
 	void SpriteComponent::renderHeader(ScenesManager& scenes, Entity* object) {
 		if(ImGui::CollapsingHeader("Sprite##sprite_component")) {
 
@@ -190,7 +212,7 @@ namespace rat {
 		object.set("setTexture", &SpriteComponent::setTexture);
 		object.set("setTextureData", &SpriteComponent::setSpriteDisplayData);
 		object.set("getTextureData", &SpriteComponent::getSpriteDisplayData);
-		object.set("getTextureSize", [](SpriteComponent& comp){return glm::vec2(comp._spriteDisplayData->getTexture().getSize());});
+		object.set("getTextureSize", [](SpriteComponent& comp){return glm::vec2(comp._spriteDisplayData->getSize());});
 		object.set("getEntity", sol::resolve<Entity*()>(&Component::getEntity));
 
 		// Entity
@@ -205,7 +227,7 @@ namespace rat {
 		if (_spriteDisplayData == nullptr)
 			return;
 
-		auto size = _spriteDisplayData->getTexture().getSize();
+		auto size = _spriteDisplayData->getSize();
 
 		glm::vec2 pos;
 
@@ -13,10 +13,13 @@ class Entity;
 class Script;
 template<class T> class ScriptClass;
 
-class SpriteComponent : public sf3d::Drawable, public Component
+class SpriteComponent : public sf3d::Drawable, public Component, public PooledComponent<SpriteComponent>
 {
 public:
 
+	/// Parallax reads only current camera, which is found and updated before
+	static constexpr bool ThreadSafeUpdate = true;
+
 	///
 	SpriteComponent(Entity* parent);
 
@@ -62,9 +65,15 @@ public:
 	///
 	void update(ScenesManager& scenes, float deltaTime);
 
+	/// Offset along X applied by parallax in last update
+	float getParallaxOffset() const;
+
 	///
 	virtual void draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const override;
 
+	/// Sprite rectangle moved by parallax
+	virtual bool getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const override;
+
 	///
 	virtual void renderHeader(ScenesManager& scenes, Entity* object) override;
 
@@ -78,7 +87,7 @@ private:
 
 private:
 
-	SpriteDisplayData* _spriteDisplayData = nullptr;
+	SpriteDisplayDataHandle _spriteDisplayData;
 
 	bool _parallax = false;
 	float _parallaxValue = 0.f;
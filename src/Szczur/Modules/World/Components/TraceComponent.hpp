@@ -16,7 +16,7 @@ class Script;
 class Entity;
 template<class T> class ScriptClass;
 
-class TraceComponent : public Component
+class TraceComponent : public Component, public PooledComponent<TraceComponent>
 {
 public:
 
@@ -94,7 +94,7 @@ namespace rat {
 	void TriggerComponent::setEntrance(const std::string& name)
 	{
 		if (auto scene = getEntity()->getScene()->getScenes()->getScene(sceneId); scene != nullptr) {
-			auto& entries = scene->getEntities("entries");
+			auto& entries = scene->getEntities(Scene::Entries);
 
 			auto entry = std::find_if(entries.begin(), entries.end(), 
 				[&] (std::unique_ptr<Entity>& entity) { 
@@ -197,58 +197,57 @@ namespace rat {
 		return _triggerShape;
 	}
 
-    void TriggerComponent::update(ScenesManager& scenes, float deltaTime) {
-    	
-    	if(!scenes.isGameRunning()) return; 
+	SpatialHash::Rect_t TriggerComponent::getBounds() const {
+		auto position = getEntity()->getPosition();
+		glm::vec2 center { position.x, position.z };
+		glm::vec2 extents = _triggerShape == Shape::Circle ? glm::vec2(_radius) : _rectSize / 2.f;
 
-        auto* player = getEntity()->getScene()->getPlayer();
-        if(player == nullptr) 
-			return;
+		return { center - extents, center + extents };
+	}
+
+	void TriggerComponent::updateSpatialHash() {
+		_spatialHashHandle.update(getEntity()->getScene()->getSpatialHash(), this, getBounds(), SpatialHash::Triggers);
+	}
+
+	void TriggerComponent::onEnter(Entity* subject) {
+		if (type == TriggerComponent::Overlaping && _enterCallback.valid())
+			_enterCallback(getEntity(), subject);
+	}
 
+	void TriggerComponent::onInside(Entity* subject) {
 		if (type == TriggerComponent::Overlaping) {
-			if (checkForTrigger(player->getPosition())) {
-				if (!_isPlayerInside) {
-					if (_enterCallback.valid())
-						_enterCallback(getEntity());
+			if (_insideCallback.valid())
+				_insideCallback(getEntity(), subject);
+		}
+		// Active trigger after [Space], only by player
+		else if (type == TriggerComponent::ChangeScene && subject == getEntity()->getScene()->getPlayer() && _input.isPressed(Keyboard::Space)) {
+			auto& scenes = *getEntity()->getScene()->getScenes();
 
-					_isPlayerInside = true;
-				}
+			// Change scene after teleport
+			if (_changingSceneWithFade) {
+				detail::globalPtr<World>->fadeIntoScene(sceneId, _fadeTime);
 
-				if (_insideCallback.valid())
-					_insideCallback(getEntity());
+				// Entries of target are needed now, not after fade
+				scenes.loadScene(sceneId);
 			}
-			else {
-				if (_isPlayerInside) {
-					if (_leaveCallback.valid())
-						_leaveCallback(getEntity());
-
-					_isPlayerInside = false;
-				}
+			else
+				scenes.setCurrentScene(sceneId);
+
+			// Set player position equal entry
+			auto* scene = scenes.getScene(sceneId);
+			if (scene == nullptr)
+				return;
+			if(auto* entry = scene->getEntity("entries", entranceId)) {
+				if (auto* player = scene->getPlayer())
+					player->setPosition(entry->getPosition());
 			}
 		}
-        // Active trigger after [Space]
-        else if(_input.isPressed(Keyboard::Space)) {
-            // Is player inside trigger
-            if(checkForTrigger(player->getPosition())) {
-                // Action for ChangeScene trigger
-                if(type == TriggerComponent::ChangeScene) {
-                    // Change scene after teleport
-
-					if (_changingSceneWithFade)
-						detail::globalPtr<World>->fadeIntoScene(sceneId, _fadeTime);
-					else
-						scenes.setCurrentScene(sceneId);
-
-                    // Set player position equal entry
-                    //auto* scene = scenes.getCurrentScene();
-					auto* scene = scenes.getScene(sceneId);
-                    if(auto* entry = scene->getEntity("entries", entranceId)) {
-                        scene->getPlayer()->setPosition(entry->getPosition());                        
-                    }
-                }
-            }
-        }
-    }
+	}
+
+	void TriggerComponent::onLeave(Entity* subject) {
+		if (type == TriggerComponent::Overlaping && _leaveCallback.valid())
+			_leaveCallback(getEntity(), subject);
+	}
 
     void TriggerComponent::initScript(ScriptClass<Entity>& entity, Script& script) {
         auto object = script.newClass<TriggerComponent>("TriggerComponent", "World");
@@ -282,7 +281,7 @@ namespace rat {
 		entity.set("trigger", &Entity::getComponentAs<TriggerComponent>);
 		entity.set("addTriggerComponent", [&] (Entity& e) {return (TriggerComponent*)e.addComponent<TriggerComponent>(); });
 
-		// overlapping
+		// overlapping, callbacks get trigger entity and subject which set it off
 
 		// enter callback
 		entity.setProperty("onEnter", [](){}, [] (Entity &obj, sol::function func) {
@@ -346,7 +345,6 @@ namespace rat {
 				if (ImGui::Selectable(enumToString(Type::Overlaping).c_str(), type == Type::Overlaping))
 				{
 					type = Type::Overlaping;
-					_isPlayerInside = false;
 				}
 				ImGui::EndCombo();
 			}
@@ -383,7 +381,7 @@ namespace rat {
                     // Find name of selected entry
                     scene = scenes.getScene(sceneId);
                     std::string name = "None";
-                    auto& entries = scene->getEntities("entries");
+                    auto& entries = scene->getEntities(Scene::Entries);
                     if(auto* entry = scene->getEntity("entries", entranceId)) {
                         name = entry->getName();
                     }
@@ -5,6 +5,7 @@
 #include <glm/vec3.hpp>
 
 #include "../Component.hpp"
+#include "../SpatialHash.hpp"
 
 namespace rat {
 
@@ -13,7 +14,7 @@ class Entity;
 class Script;
 template<class T> class ScriptClass;
 
-class TriggerComponent : public Component {
+class TriggerComponent : public Component, public PooledComponent<TriggerComponent> {
 public:
 
 	///
@@ -93,8 +94,20 @@ public:
 	///
 	virtual void renderHeader(ScenesManager& scenes, Entity* object) override;
 
-    ///
-    void update(ScenesManager& scenes, float deltaTime);
+	/// Box or circle around entity on XZ plane
+	SpatialHash::Rect_t getBounds() const;
+
+	/// Moves trigger volume in spatial hash of its scene, called each frame by scene
+	void updateSpatialHash();
+
+	/// Called by trigger system when subject enters volume
+	void onEnter(Entity* subject);
+
+	/// Called by trigger system each frame subject is inside volume
+	void onInside(Entity* subject);
+
+	/// Called by trigger system when subject leaves volume
+	void onLeave(Entity* subject);
 
 	///
 	static void initScript(ScriptClass<Entity>& entity, Script& script);
@@ -110,11 +123,12 @@ private:
 	bool _changingSceneWithFade = false;
 	float _fadeTime = 1.f;
 
-	bool _isPlayerInside = false;
 	sol::function _enterCallback;
 	sol::function _insideCallback;
 	sol::function _leaveCallback;
 
+	SpatialHashHandle _spatialHashHandle;
+
 };
 
 }
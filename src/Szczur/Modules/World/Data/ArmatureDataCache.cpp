@@ -0,0 +1,175 @@
+#include "ArmatureDataCache.hpp"
+
+#include <stdexcept>
+#include <system_error>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include "Szczur/Modules/DragonBones/SF3DFactory.hpp"
+#include "Szczur/Utility/Logger.hpp"
+#include "Szczur/Utility/MappedFile.hpp"
+
+namespace rat
+{
+
+namespace
+{
+	Hash64_t hashFile(const MappedFile& file)
+	{
+		return fnv1a_64(file.getData(), file.getData() + file.getSize());
+	}
+
+	Hash64_t combine(Hash64_t seed, Hash64_t value)
+	{
+		return seed ^ (value + 0x9E3779B97F4A7C15ull + (seed << 6) + (seed >> 2));
+	}
+}
+
+ArmatureDataCache& ArmatureDataCache::get()
+{
+	static ArmatureDataCache instance;
+	return instance;
+}
+
+Hash64_t ArmatureDataCache::acquire(const std::string& skeletonPath, const std::string& atlasPath, const std::string& texturePath, const std::string& name)
+{
+	// Unchanged files of known paths are not read again
+	const std::string paths = skeletonPath + '\n' + atlasPath + '\n' + texturePath;
+	const Stamps_t stamps { _getStamp(skeletonPath), _getStamp(atlasPath), _getStamp(texturePath) };
+
+	if (auto path = _paths.find(paths); path != _paths.end() && path->second.stamps == stamps)
+	{
+		if (auto it = _entries.find(path->second.key); it != _entries.end())
+		{
+			++it->second.references;
+			return it->first;
+		}
+	}
+
+	const MappedFile skeleton(skeletonPath);
+	const MappedFile atlas(atlasPath);
+	const MappedFile image(texturePath);
+
+	const Hash64_t key = combine(combine(hashFile(skeleton), hashFile(atlas)), hashFile(image));
+	_paths[paths] = { stamps, key };
+
+	if (auto it = _entries.find(key); it != _entries.end())
+	{
+		++it->second.references;
+		return key;
+	}
+
+	auto dbFactory = dragonBones::SF3DFactory::get();
+
+	Entry entry;
+	entry.name = name;
+
+	// Same name with other content, e.g. armatures from different folders
+	if (dbFactory->getDragonBonesData(entry.name))
+	{
+		entry.name += "#" + std::to_string(key);
+	}
+
+	// Image is decoded from mapping too, so each file is read once
+	sf::Image decoded;
+	if (!decoded.loadFromMemory(image.getData(), image.getSize()))
+	{
+		throw std::runtime_error("Cannot load texture from " + texturePath);
+	}
+	entry.texture = std::make_unique<sf3d::Texture>();
+	entry.texture->loadFromMemory(decoded.getPixelsPtr(), {decoded.getSize().x, decoded.getSize().y});
+
+	if (!dbFactory->loadDragonBonesData(skeleton, entry.name))
+	{
+		throw std::runtime_error("Cannot parse armature skeleton " + skeletonPath);
+	}
+
+	if (!dbFactory->loadTextureAtlasData(atlas, entry.texture.get(), entry.name))
+	{
+		dbFactory->removeDragonBonesData(entry.name);
+		throw std::runtime_error("Cannot parse armature atlas " + atlasPath);
+	}
+
+	entry.references = 1;
+	++_parsesCount;
+
+	_entries.emplace(key, std::move(entry));
+
+	return key;
+}
+
+void ArmatureDataCache::release(Hash64_t key)
+{
+	auto it = _entries.find(key);
+
+	if (it == _entries.end() || --it->second.references > 0)
+	{
+		return;
+	}
+
+	LOG_INFO("Removing armature data: '", it->second.name, "'...");
+
+	auto dbFactory = dragonBones::SF3DFactory::get();
+
+	dbFactory->removeDragonBonesData(it->second.name);
+	dbFactory->removeTextureAtlasData(it->second.name);
+
+	_entries.erase(it);
+}
+
+void ArmatureDataCache::clear()
+{
+	auto dbFactory = dragonBones::SF3DFactory::get();
+
+	for (auto& [key, entry] : _entries)
+	{
+		LOG_WARNING_IF(entry.references > 0, "Armature data '", entry.name, "' is still used by ", entry.references, " display data");
+
+		dbFactory->removeDragonBonesData(entry.name);
+		dbFactory->removeTextureAtlasData(entry.name);
+	}
+
+	_entries.clear();
+	_paths.clear();
+}
+
+const std::string& ArmatureDataCache::getDataName(Hash64_t key) const
+{
+	static const std::string empty;
+
+	auto it = _entries.find(key);
+	return it != _entries.end() ? it->second.name : empty;
+}
+
+size_t ArmatureDataCache::getReferences(Hash64_t key) const
+{
+	auto it = _entries.find(key);
+	return it != _entries.end() ? it->second.references : 0;
+}
+
+size_t ArmatureDataCache::getSize() const
+{
+	return _entries.size();
+}
+
+size_t ArmatureDataCache::getParsesCount() const
+{
+	return _parsesCount;
+}
+
+ArmatureDataCache::FileStamp ArmatureDataCache::_getStamp(const std::string& path)
+{
+	namespace fs = std::experimental::filesystem;
+
+	// Missing file gets empty stamp, mapping it reports error
+	std::error_code sizeError;
+	std::error_code timeError;
+	FileStamp stamp { fs::file_size(path, sizeError), fs::last_write_time(path, timeError) };
+	if (sizeError || timeError)
+	{
+		stamp = {};
+	}
+	return stamp;
+}
+
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <experimental/filesystem>
+#include <memory>
+#include <string>
+#include <unordered_map>
+
+#include "Szczur/Utility/SFML3D/Texture.hpp"
+#include "Szczur/Utility/Convert/Hash.hpp"
+
+namespace rat
+{
+
+/// Skeletons and atlases parsed into DragonBones factory, shared by all armature display data with same files content
+class ArmatureDataCache
+{
+public:
+
+	/// Parsed data of one content
+	struct Entry
+	{
+		/// Name of data in factory, differs from armature name if other content took it first
+		std::string name;
+		std::unique_ptr<sf3d::Texture> texture;
+		size_t references = 0;
+	};
+
+	///
+	static ArmatureDataCache& get();
+
+	// Non-copyable
+	ArmatureDataCache(const ArmatureDataCache&) = delete;
+	ArmatureDataCache& operator = (const ArmatureDataCache&) = delete;
+
+	/// Returns key of files content, already parsed content is only referenced again. Files are mapped and hashed only if their paths,
+	/// sizes or modification times are not known yet. Throws if files cannot be read or parsed
+	Hash64_t acquire(const std::string& skeletonPath, const std::string& atlasPath, const std::string& texturePath, const std::string& name);
+
+	/// Data is removed from factory when last reference is released
+	void release(Hash64_t key);
+
+	/// Removes all data from factory, must be called before armatures and graphics context are destroyed
+	void clear();
+
+	/// Name to build armatures of content with, empty for unknown key
+	const std::string& getDataName(Hash64_t key) const;
+
+	///
+	size_t getReferences(Hash64_t key) const;
+
+	/// Number of different contents parsed
+	size_t getSize() const;
+
+	/// Number of times files were parsed since start
+	size_t getParsesCount() const;
+
+private:
+
+	/// Size and modification time of file, changes if file is changed
+	struct FileStamp
+	{
+		std::uintmax_t size;
+		std::experimental::filesystem::file_time_type time;
+
+		bool operator == (const FileStamp& other) const
+		{
+			return size == other.size && time == other.time;
+		}
+	};
+
+	using Stamps_t = std::array<FileStamp, 3>;
+
+	/// Content key last found for files with given stamps
+	struct PathEntry
+	{
+		Stamps_t stamps;
+		Hash64_t key;
+	};
+
+	///
+	ArmatureDataCache() = default;
+
+	///
+	static FileStamp _getStamp(const std::string& path);
+
+	std::unordered_map<Hash64_t, Entry> _entries;
+	std::unordered_map<std::string, PathEntry> _paths;
+	size_t _parsesCount = 0;
+
+};
+
+}
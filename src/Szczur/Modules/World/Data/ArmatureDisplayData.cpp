@@ -1,15 +1,14 @@
 #include "ArmatureDisplayData.hpp"
 
-#include <chrono>
 #include <experimental/filesystem>
  
-#include "Szczur/Modules/DragonBones/SF3DFactory.hpp"
+#include "ArmatureDataCache.hpp"
+
 #include "Szczur/Utility/Logger.hpp"
+#include "Szczur/Utility/FileWatcher.hpp"
 
 #include "Szczur/Modules/FileSystem/DragDrop.hpp"
 
-using std::chrono::system_clock;
-
 namespace rat
 {
  
@@ -18,13 +17,22 @@ ArmatureDisplayData::ArmatureDisplayData(const std::string& path)
 {
 	_name = std::experimental::filesystem::path(path).filename().string();
 
-	checkForReload();
 	load();
-	_needReload = false;
+
+	// Armature is reloaded at next game start, when any of its files changes
+	for (auto file : { _skeFilePath, _textureAtlasFilePath, _textureFilePath }) {
+		_watches.push_back(FileWatcher::get().watch(_folderPath + file, [this](const std::string&) {
+			_needReload = true;
+		}));
+	}
 }
     
 ArmatureDisplayData::~ArmatureDisplayData() 
 {
+	for (auto watch : _watches) {
+		FileWatcher::get().unwatch(watch);
+	}
+
 	unload();
 }
 
@@ -32,61 +40,54 @@ void ArmatureDisplayData::load()
 {
 	LOG_INFO("Loading armature data: '", _name, "'...");
 
-	auto dbFactory = dragonBones::SF3DFactory::get();
-
-	_texture = new sf3d::Texture;
-	_texture->loadFromFile(_folderPath + _textureFilePath);
-
-	dbFactory->loadDragonBonesData(_folderPath  + _skeFilePath, _name);
-	dbFactory->loadTextureAtlasData(_folderPath + _textureAtlasFilePath, _texture, _name);
+	_key = ArmatureDataCache::get().acquire(_folderPath + _skeFilePath, _folderPath + _textureAtlasFilePath, _folderPath + _textureFilePath, _name);
+	_loaded = true;
 }
 
 void ArmatureDisplayData::unload()
 {
-	LOG_INFO("Removing armature data: '", _name, "'...");
-
-	auto dbFactory = dragonBones::SF3DFactory::get();
-
-	dbFactory->removeDragonBonesData(_name);
-	dbFactory->removeTextureAtlasData(_name);
-	delete _texture;
+	if (_loaded)
+	{
+		ArmatureDataCache::get().release(_key);
+		_loaded = false;
+	}
 }
 
 void ArmatureDisplayData::reload()
 {
-	checkForReload();
-
 	if (_needReload)
 	{
-		unload();
-		load();
+		// New content is acquired first, so unchanged files are not parsed again
+		const bool wasLoaded = _loaded;
+		const Hash64_t oldKey = _key;
+
+		try
+		{
+			load();
+		}
+		catch (std::exception& ex)
+		{
+			LOG_EXCEPTION(ex);
+			return;
+		}
+
+		if (wasLoaded)
+		{
+			ArmatureDataCache::get().release(oldKey);
+		}
 
 		_needReload = false;
 	}
 }
 
-void ArmatureDisplayData::checkForReload()
+const std::string& ArmatureDisplayData::getDataName() const
 {
-	namespace fs = std::experimental::filesystem;
-
-#ifndef PSYCHOX // Przepraszam :C 
-	auto lastSkeFileUpdate			= system_clock::to_time_t(fs::last_write_time(_folderPath + _skeFilePath));
-	auto lastTextureAtlasFileUpdate = system_clock::to_time_t(fs::last_write_time(_folderPath + _textureAtlasFilePath));
-	auto lastTextureFileUpdate		= system_clock::to_time_t(fs::last_write_time(_folderPath + _textureFilePath));
-	
-	if (lastSkeFileUpdate			!= _lastSkeFileUpdate ||
-		lastTextureAtlasFileUpdate	!= _lastTextureAtlasFileUpdate ||
-		lastTextureFileUpdate		!= _lastTextureFileUpdate)
-	{
-		_lastSkeFileUpdate = lastSkeFileUpdate;
-		_lastTextureAtlasFileUpdate = lastTextureAtlasFileUpdate;
-		_lastTextureFileUpdate = lastTextureFileUpdate;
-		_needReload = true;
-	}
-#else
-	_needReload = true;
-#endif
+	return ArmatureDataCache::get().getDataName(_key);
 }
- 
+
+bool ArmatureDisplayData::needsReload() const
+{
+	return _needReload;
 }
  
+}
@@ -1,10 +1,11 @@
 #pragma once
  
-#include <ctime>
+#include <vector>
 
 #include "Szczur/Utility/SFML3D/Drawable.hpp"
  
 #include "Szczur/Modules/DragonBones/SF3DArmatureDisplay.hpp"
+#include "Szczur/Utility/Convert/Hash.hpp"
  
 namespace rat
 { 
@@ -12,15 +13,15 @@ namespace rat
 class ArmatureDisplayData
 {
 private:
-    sf3d::Texture* _texture;
+	// Parsed data is shared through cache by all display data with same files
+	Hash64_t _key = 0;
+	bool _loaded = false;
 
     std::string _name;
     std::string _folderPath;
 
 	bool _needReload = false;
-	std::time_t _lastSkeFileUpdate = 0;
-	std::time_t _lastTextureAtlasFileUpdate = 0;
-	std::time_t _lastTextureFileUpdate = 0;
+	std::vector<std::size_t> _watches;
 
 protected:
     constexpr static auto _assetsFolderPath = "";
@@ -34,12 +35,20 @@ public:
 
 	void load();
 	void unload();
+
+	/// Reloads if any file changed since loading
 	void reload();
 
-	void checkForReload();
+	bool needsReload() const;
+
+	/// Name of data in factory, to build armatures with
+	const std::string& getDataName() const;
+
+	/// Key of files content in armature data cache
+	Hash64_t getContentKey() const { return _key; }
 
-    const auto& getName() { return _name; }
-    const auto& getFolderPath() { return _folderPath; }
+    const auto& getName() const { return _name; }
+    const auto& getFolderPath() const { return _folderPath; }
 };
  
 }
@@ -18,6 +18,7 @@ namespace rat {
         try {
             _texture.loadFromFile(_name);
             _sprite.setTexture(_texture);
+            _loaded = true;
         }
         catch (const std::exception& e) {
             LOG_INFO(e.what());
@@ -34,11 +35,95 @@ namespace rat {
     }
 
     void SpriteDisplayData::setupSprite() {
+        _atlasPage = nullptr;
         _sprite.setTexture(_texture);
+        _loaded = true;
+    }
+
+    void SpriteDisplayData::loadTexture(const void* pixels, glm::uvec2 size) {
+        _texture.loadFromMemory(pixels, size);
+        setupSprite();
+    }
+
+    void SpriteDisplayData::setPlaceholder(const sf3d::Texture& texture) {
+        if (!_loaded) {
+            _sprite.setTexture(texture);
+        }
+    }
+
+    void SpriteDisplayData::setAtlasRegion(const sf3d::Texture& page, glm::uvec2 position, glm::uvec2 size) {
+        // Own texture is not needed anymore
+        _texture = sf3d::Texture();
+        _atlasPage = &page;
+        _atlasPosition = position;
+        _atlasSize = size;
+        _loaded = true;
+        _sprite.setTexture(page, position, size);
+    }
+
+    bool SpriteDisplayData::isInAtlas() const {
+        return _atlasPage != nullptr;
+    }
+
+    bool SpriteDisplayData::isLoaded() const {
+        return _loaded;
+    }
+
+    void SpriteDisplayData::unloadTexture(const sf3d::Texture& placeholder) {
+        _texture = sf3d::Texture();
+        _atlasPage = nullptr;
+        _loaded = false;
+        _sprite.setTexture(placeholder);
+    }
+
+    size_t SpriteDisplayData::getMemorySize() const {
+        // Atlas pages are owned by atlas
+        if (!_loaded || _atlasPage) {
+            return 0;
+        }
+        const auto size = _texture.getSize();
+        return static_cast<size_t>(size.x) * size.y * 4 * 4 / 3;
+    }
+
+    void SpriteDisplayData::markUsed() const {
+        _used = true;
+    }
+
+    bool SpriteDisplayData::takeUsed() const {
+        const bool used = _used;
+        _used = false;
+        return used;
+    }
+
+    void SpriteDisplayData::addReference() {
+        ++_references;
+    }
+
+    void SpriteDisplayData::removeReference() {
+        --_references;
+    }
+
+    size_t SpriteDisplayData::getReferencesCount() const {
+        return _references;
     }
 
     const sf3d::Texture& SpriteDisplayData::getTexture() const {    
-        return _texture;
+        return _atlasPage ? *_atlasPage : _texture;
+    }
+
+    glm::uvec2 SpriteDisplayData::getSize() const {
+        return _atlasPage ? _atlasSize : _texture.getSize();
+    }
+
+    glm::vec2 SpriteDisplayData::getTexCoord(glm::vec2 pixel) const {
+        const glm::vec2 textureSize = getTexture().getSize();
+        if (textureSize.x == 0.f || textureSize.y == 0.f) {
+            return {0.f, 0.f};
+        }
+        if (_atlasPage) {
+            pixel += glm::vec2(_atlasPosition);
+        }
+        return pixel / textureSize;
     }
 
     const std::string& SpriteDisplayData::getName() const {
@@ -46,7 +131,8 @@ namespace rat {
     }
 
     void SpriteDisplayData::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const {
-        states.texture = &_texture;
+        // Sprite holds placeholder texture until loaded
+        markUsed();
         target.draw(_sprite, states);
     }
 }
@@ -29,9 +29,51 @@ public:
 	///
 	void setupSprite();
 
+	/// Uploads decoded RGBA pixels and uses them for sprite
+	void loadTexture(const void* pixels, glm::uvec2 size);
+
+	/// Texture drawn until real one is loaded
+	void setPlaceholder(const sf3d::Texture& texture);
+
+	/// Uses part of atlas page instead of own texture
+	void setAtlasRegion(const sf3d::Texture& page, glm::uvec2 position, glm::uvec2 size);
+
+	///
+	bool isInAtlas() const;
+
+	///
+	bool isLoaded() const;
+
+	/// Frees texture memory, placeholder is drawn until texture is loaded again
+	void unloadTexture(const sf3d::Texture& placeholder);
+
+	/// Estimated video memory taken by texture with mipmaps
+	size_t getMemorySize() const;
+
+	/// Marks data as needed in current frame, called when drawn
+	void markUsed() const;
+
+	/// Returns and clears used mark
+	bool takeUsed() const;
+
 	///
+	void addReference();
+
+	///
+	void removeReference();
+
+	/// Number of handles which refer to this data
+	size_t getReferencesCount() const;
+
+	/// Texture to bind, atlas page if data is packed in atlas
 	const sf3d::Texture& getTexture() const;
 
+	/// Size of image in pixels
+	glm::uvec2 getSize() const;
+
+	/// Maps pixel position in image to texture coordinates of `getTexture()`
+	glm::vec2 getTexCoord(glm::vec2 pixel) const;
+
 	///
 	const std::string& getName() const;
 
@@ -48,6 +90,79 @@ private:
 	std::string _name;
 	sf3d::Sprite _sprite;
 	sf3d::Texture _texture;
+	const sf3d::Texture* _atlasPage = nullptr;
+	glm::uvec2 _atlasPosition {0u, 0u};
+	glm::uvec2 _atlasSize {0u, 0u};
+	bool _loaded = false;
+	size_t _references = 0;
+	mutable bool _used = false;
+
+};
+
+/// Pointer to sprite display data which keeps it referenced, so it is not released as unused
+class SpriteDisplayDataHandle
+{
+public:
+
+	///
+	SpriteDisplayDataHandle() = default;
+
+	///
+	SpriteDisplayDataHandle(SpriteDisplayData* data)
+		: _data { data }
+	{
+		if (_data) _data->addReference();
+	}
+
+	///
+	SpriteDisplayDataHandle(const SpriteDisplayDataHandle& rhs)
+		: SpriteDisplayDataHandle { rhs._data }
+	{
+
+	}
+
+	///
+	SpriteDisplayDataHandle& operator = (const SpriteDisplayDataHandle& rhs)
+	{
+		reset(rhs._data);
+		return *this;
+	}
+
+	///
+	~SpriteDisplayDataHandle()
+	{
+		reset(nullptr);
+	}
+
+	///
+	void reset(SpriteDisplayData* data)
+	{
+		if (data) data->addReference();
+		if (_data) _data->removeReference();
+		_data = data;
+	}
+
+	///
+	SpriteDisplayData* get() const
+	{
+		return _data;
+	}
+
+	///
+	SpriteDisplayData* operator -> () const
+	{
+		return _data;
+	}
+
+	///
+	operator SpriteDisplayData* () const
+	{
+		return _data;
+	}
+
+private:
+
+	SpriteDisplayData* _data = nullptr;
 
 };
 
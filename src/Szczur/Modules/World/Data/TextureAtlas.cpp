@@ -0,0 +1,308 @@
+#include "TextureAtlas.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+#include <Szczur/Utility/Logger.hpp>
+#include <Szczur/Utility/Convert/Windows1250.hpp>
+
+namespace rat {
+
+TextureAtlas::Skyline::Skyline(unsigned width) {
+	nodes.push_back({0u, 0u, width});
+}
+
+bool TextureAtlas::Skyline::find(glm::uvec2 size, glm::uvec2 pageSize, glm::uvec2& position, size_t& nodeIndex) const {
+	unsigned bestBottom = pageSize.y + 1;
+	unsigned bestWidth = pageSize.x + 1;
+	bool found = false;
+
+	for(size_t i = 0; i < nodes.size(); ++i) {
+		const unsigned x = nodes[i].x;
+		if(x + size.x > pageSize.x) {
+			break;
+		}
+
+		// Rectangle lies on highest node below it
+		unsigned y = 0;
+		unsigned widthLeft = size.x;
+		for(size_t j = i; widthLeft > 0 && j < nodes.size(); ++j) {
+			y = std::max(y, nodes[j].y);
+			widthLeft -= std::min(widthLeft, nodes[j].width);
+		}
+		if(y + size.y > pageSize.y) {
+			continue;
+		}
+
+		if(y + size.y < bestBottom || (y + size.y == bestBottom && nodes[i].width < bestWidth)) {
+			bestBottom = y + size.y;
+			bestWidth = nodes[i].width;
+			position = {x, y};
+			nodeIndex = i;
+			found = true;
+		}
+	}
+
+	return found;
+}
+
+void TextureAtlas::Skyline::insert(size_t nodeIndex, glm::uvec2 position, glm::uvec2 size) {
+	nodes.insert(nodes.begin() + nodeIndex, Node{position.x, position.y + size.y, size.x});
+
+	// Cut nodes covered by new one
+	for(size_t i = nodeIndex + 1; i < nodes.size();) {
+		const unsigned previousEnd = nodes[i - 1].x + nodes[i - 1].width;
+		if(nodes[i].x >= previousEnd) {
+			break;
+		}
+		const unsigned shrink = previousEnd - nodes[i].x;
+		if(nodes[i].width <= shrink) {
+			nodes.erase(nodes.begin() + i);
+			continue;
+		}
+		nodes[i].x += shrink;
+		nodes[i].width -= shrink;
+		break;
+	}
+
+	// Merge neighbours on same height
+	for(size_t i = 1; i < nodes.size();) {
+		if(nodes[i - 1].y == nodes[i].y) {
+			nodes[i - 1].width += nodes[i].width;
+			nodes.erase(nodes.begin() + i);
+		}
+		else {
+			++i;
+		}
+	}
+}
+
+TextureAtlas::TextureAtlas(glm::uvec2 pageSize, unsigned padding)
+	: _pageSize { pageSize }, _padding { padding } {
+
+}
+
+void TextureAtlas::build(const std::vector<std::string>& files) {
+	_regions.clear();
+	_images.clear();
+	_pages.clear();
+
+	struct Source {
+		const std::string* name;
+		sf::Image image;
+	};
+
+	// Decode all images first, so they can be sorted by size
+	std::vector<Source> sources;
+	sources.reserve(files.size());
+	for(auto& file : files) {
+		if(_regions.count(file)) {
+			continue;
+		}
+		Source source { &file, {} };
+		if(!source.image.loadFromFile(file)) {
+			LOG_ERROR("Cannot load texture from ", file);
+			continue;
+		}
+		const auto size = source.image.getSize();
+		if(size.x + _padding > _pageSize.x || size.y + _padding > _pageSize.y) {
+			LOG_WARNING("Texture ", file, " is bigger than atlas page, it will be loaded separately");
+			continue;
+		}
+		_regions[file] = Region{0, {0u, 0u}, {size.x, size.y}};
+		sources.push_back(std::move(source));
+	}
+
+	// Higher textures first gives flatter skyline
+	std::sort(sources.begin(), sources.end(), [](const Source& a, const Source& b) {
+		const auto sizeA = a.image.getSize();
+		const auto sizeB = b.image.getSize();
+		return sizeA.y != sizeB.y ? sizeA.y > sizeB.y : sizeA.x > sizeB.x;
+	});
+
+	std::vector<Skyline> skylines;
+	std::vector<unsigned> usedHeights;
+	for(auto& source : sources) {
+		auto& region = _regions[*source.name];
+		const glm::uvec2 paddedSize = region.size + glm::uvec2(_padding);
+
+		glm::uvec2 position;
+		size_t nodeIndex;
+		size_t page = 0;
+		for(; page < skylines.size(); ++page) {
+			if(skylines[page].find(paddedSize, _pageSize, position, nodeIndex)) {
+				break;
+			}
+		}
+		if(page == skylines.size()) {
+			skylines.emplace_back(_pageSize.x);
+			usedHeights.push_back(0u);
+			skylines.back().find(paddedSize, _pageSize, position, nodeIndex);
+		}
+
+		skylines[page].insert(nodeIndex, position, paddedSize);
+		usedHeights[page] = std::max(usedHeights[page], position.y + region.size.y);
+
+		region.page = page;
+		region.position = position;
+	}
+
+	// Pages are cut to used height to save memory
+	_images.resize(skylines.size());
+	for(size_t i = 0; i < _images.size(); ++i) {
+		_images[i].create(_pageSize.x, std::max(usedHeights[i], 1u), sf::Color::Transparent);
+	}
+	for(auto& source : sources) {
+		const auto& region = _regions[*source.name];
+		_images[region.page].copy(source.image, region.position.x, region.position.y);
+	}
+
+	LOG_INFO("Packed ", sources.size(), " textures into ", _images.size(), " atlas pages");
+}
+
+void TextureAtlas::saveToFile(const std::string& path) const {
+	nlohmann::json config;
+	config["pageSize"] = { _pageSize.x, _pageSize.y };
+	config["padding"] = _padding;
+	config["pages"] = _images.size();
+
+	auto& regions = config["regions"] = nlohmann::json::object();
+	for(auto& [name, region] : _regions) {
+		regions[mapWindows1250ToUtf8(name)] = { region.page, region.position.x, region.position.y, region.size.x, region.size.y };
+	}
+
+	for(size_t i = 0; i < _images.size(); ++i) {
+		if(!_images[i].saveToFile(_getPagePath(path, i))) {
+			throw std::runtime_error("Cannot save atlas page to " + _getPagePath(path, i));
+		}
+	}
+
+	std::ofstream file { path };
+	file << std::setw(4) << config << std::endl;
+}
+
+void TextureAtlas::loadFromFile(const std::string& path) {
+	std::ifstream file { path };
+	if(!file) {
+		throw std::runtime_error("Cannot open atlas index " + path);
+	}
+	nlohmann::json config;
+	file >> config;
+
+	_path = path;
+	_pageSize = { config["pageSize"][0].get<unsigned>(), config["pageSize"][1].get<unsigned>() };
+	_padding = config["padding"];
+
+	_regions.clear();
+	for(auto it = config["regions"].begin(); it != config["regions"].end(); ++it) {
+		auto& value = it.value();
+		_regions[mapUtf8ToWindows1250(it.key())] = Region {
+			value[0].get<size_t>(),
+			{ value[1].get<unsigned>(), value[2].get<unsigned>() },
+			{ value[3].get<unsigned>(), value[4].get<unsigned>() }
+		};
+	}
+
+	_images.clear();
+	_images.resize(config["pages"].get<size_t>());
+	for(size_t i = 0; i < _images.size(); ++i) {
+		if(!_images[i].loadFromFile(_getPagePath(path, i))) {
+			throw std::runtime_error("Cannot load atlas page from " + _getPagePath(path, i));
+		}
+	}
+}
+
+void TextureAtlas::upload() {
+	_pages.clear();
+	_pages.resize(_images.size());
+	for(size_t i = 0; i < _images.size(); ++i) {
+		const auto size = _images[i].getSize();
+		_pages[i].loadFromMemory(_images[i].getPixelsPtr(), {size.x, size.y});
+	}
+	_images.clear();
+}
+
+const TextureAtlas::Region* TextureAtlas::find(const std::string& name) const {
+	if(auto it = _regions.find(name); it != _regions.end()) {
+		return &it->second;
+	}
+	return nullptr;
+}
+
+const sf3d::Texture& TextureAtlas::getPage(size_t index) const {
+	return _pages[index];
+}
+
+size_t TextureAtlas::getPagesCount() const {
+	return std::max(_pages.size(), _images.size());
+}
+
+size_t TextureAtlas::getRegionsCount() const {
+	return _regions.size();
+}
+
+const std::string& TextureAtlas::getPath() const {
+	return _path;
+}
+
+std::string TextureAtlas::getPathForWorld(const std::string& worldPath) {
+	const auto dot = worldPath.find_last_of('.');
+	return worldPath.substr(0, dot) + ".atlas";
+}
+
+std::vector<std::string> TextureAtlas::collectTextures(const nlohmann::json& config) {
+	std::vector<std::string> files;
+
+	// Sprite components store texture path as `spriteDisplayData`
+	auto visit = [&files](const nlohmann::json& value, auto& visit) -> void {
+		if(value.is_object()) {
+			for(auto it = value.begin(); it != value.end(); ++it) {
+				if(it.key() == "spriteDisplayData" && it.value().is_string()) {
+					auto name = mapUtf8ToWindows1250(it.value().get<std::string>());
+					if(!name.empty()) {
+						files.push_back(std::move(name));
+					}
+				}
+				else {
+					visit(it.value(), visit);
+				}
+			}
+		}
+		else if(value.is_array()) {
+			for(auto& element : value) {
+				visit(element, visit);
+			}
+		}
+	};
+	visit(config, visit);
+
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+	return files;
+}
+
+std::vector<std::string> TextureAtlas::collectTextures(const std::vector<std::string>& worldFiles) {
+	std::vector<std::string> files;
+	for(auto& worldFile : worldFiles) {
+		std::ifstream file { worldFile };
+		nlohmann::json config;
+		file >> config;
+
+		auto worldTextures = collectTextures(config);
+		files.insert(files.end(), worldTextures.begin(), worldTextures.end());
+	}
+
+	std::sort(files.begin(), files.end());
+	files.erase(std::unique(files.begin(), files.end()), files.end());
+	return files;
+}
+
+std::string TextureAtlas::_getPagePath(const std::string& path, size_t index) {
+	return path + "_" + std::to_string(index) + ".png";
+}
+
+}
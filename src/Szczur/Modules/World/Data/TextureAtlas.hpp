@@ -0,0 +1,103 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <unordered_map>
+
+#include <glm/vec2.hpp>
+
+#include <SFML/Graphics/Image.hpp>
+
+#include <nlohmann/json_fwd.hpp>
+
+#include <Szczur/Utility/SFML3D/Texture.hpp>
+
+namespace rat {
+
+/// Few large pages with many textures packed inside, so sprites can share texture and be batched
+class TextureAtlas
+{
+public:
+
+	/// Place of packed texture
+	struct Region {
+		size_t page;
+		glm::uvec2 position;
+		glm::uvec2 size;
+	};
+
+	///
+	TextureAtlas(glm::uvec2 pageSize = {4096u, 4096u}, unsigned padding = 2u);
+
+	/// Packs given textures into pages, textures bigger than page are skipped
+	void build(const std::vector<std::string>& files);
+
+	/// Writes index to `path` and pages next to it as `path_N.png`
+	void saveToFile(const std::string& path) const;
+
+	/// Reads index and pages written by `saveToFile`
+	void loadFromFile(const std::string& path);
+
+	/// Creates textures from packed pages and frees their pixels
+	void upload();
+
+	/// Returns region of packed texture or nullptr
+	const Region* find(const std::string& name) const;
+
+	///
+	const sf3d::Texture& getPage(size_t index) const;
+
+	///
+	size_t getPagesCount() const;
+
+	///
+	size_t getRegionsCount() const;
+
+	///
+	const std::string& getPath() const;
+
+	/// Path of index file written for given world file
+	static std::string getPathForWorld(const std::string& worldPath);
+
+	/// Textures used by sprites in world config
+	static std::vector<std::string> collectTextures(const nlohmann::json& config);
+
+	/// Textures used by sprites in world files
+	static std::vector<std::string> collectTextures(const std::vector<std::string>& worldFiles);
+
+private:
+
+	/// Bottom-left skyline of single page
+	struct Skyline {
+		struct Node {
+			unsigned x;
+			unsigned y;
+			unsigned width;
+		};
+
+		std::vector<Node> nodes;
+
+		///
+		Skyline(unsigned width);
+
+		/// Finds lowest position for rectangle, returns false if it does not fit
+		bool find(glm::uvec2 size, glm::uvec2 pageSize, glm::uvec2& position, size_t& nodeIndex) const;
+
+		///
+		void insert(size_t nodeIndex, glm::uvec2 position, glm::uvec2 size);
+	};
+
+	///
+	static std::string _getPagePath(const std::string& path, size_t index);
+
+	glm::uvec2 _pageSize;
+	unsigned _padding;
+	std::string _path;
+
+	std::unordered_map<std::string, Region> _regions;
+	std::vector<sf::Image> _images;
+	std::vector<sf3d::Texture> _pages;
+
+};
+
+}
@@ -1,12 +1,16 @@
 #include "TextureDataHolder.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <thread>
-#include <experimental/filesystem>
-
+#include <vector>
 
 #include "SpriteDisplayData.hpp"
+#include "TextureAtlas.hpp"
 
 #include <Szczur/Utility/Logger.hpp>
+#include <Szczur/Utility/FileWatcher.hpp>
+#include <Szczur/Utility/Profiler.hpp>
 
 #include <Szczur/Modules/Script/Script.hpp>
 
@@ -14,57 +18,129 @@ namespace rat {
 
 TextureDataHolder::TextureData::TextureData(SpriteDisplayData* data)
 	: data(data), reloaded(false) {
-#ifndef PSYCHOX
-	lastWriten = std::experimental::filesystem::last_write_time(data->getName());	
-#endif
 }
 
-bool TextureDataHolder::TextureData::checkTime() {
-#ifndef PSYCHOX
-	return lastWriten == std::experimental::filesystem::last_write_time(data->getName());	
-#else
-	return false;
-#endif
+TextureDataHolder::TextureDataHolder() {
 }
 
-void TextureDataHolder::TextureData::updateTime() {
-#ifndef PSYCHOX
-	lastWriten = std::experimental::filesystem::last_write_time(data->getName());
-#endif
-}
+TextureDataHolder::~TextureDataHolder() {
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stopWorkers = true;
+	}
+	_condition.notify_all();
+	for(auto& worker : _workers) {
+		worker.join();
+	}
 
-const sf3d::Texture& TextureDataHolder::getTexture(const std::string& filePath, bool reload) {
+	for(auto& obj : _data) {
+		FileWatcher::get().unwatch(obj.watch);
+	}
+}
 
-	// If same texture is loaded
+const sf3d::Texture& TextureDataHolder::getTexture(const std::string& filePath) {
 	if(auto* data = find(filePath)) {
-		if(reload && !data->checkTime()) {
-			data->reloaded = false;
-			_allLoaded = false;			
-		}
 		return data->data->getTexture();
 	}
-
-	auto& data = _data.emplace_back(new SpriteDisplayData(filePath));
-	_allLoaded = false;
-
-	return data.data->getTexture();
+	return _add(filePath).data->getTexture();
 }
 	
-SpriteDisplayData* TextureDataHolder::getData(const std::string& filePath, bool reload) {
-	
-	// If same texture is loaded
+SpriteDisplayData* TextureDataHolder::getData(const std::string& filePath) {
 	if(auto* data = find(filePath)) {
-		if(reload && !data->checkTime()) {
-			data->reloaded = false;
-			_allLoaded = false;
-		}
 		return data->data.get();
 	}
+	return _add(filePath).data.get();
+}
+
+TextureDataHolder::TextureData& TextureDataHolder::_add(const std::string& filePath) {
+	_index[fnv1a_64(filePath.begin(), filePath.end())] = _data.size();
 
 	auto& data = _data.emplace_back(new SpriteDisplayData(filePath));
+	data.data->setPlaceholder(_getPlaceholder());
+	data.lastUsedFrame = _frame;
 	_allLoaded = false;
 
-	return data.data.get();
+	// Changed file is loaded again with next textures
+	data.watch = FileWatcher::get().watch(filePath, [this, filePath](const std::string&) {
+		if(auto* obj = find(filePath)) {
+			obj->reloaded = false;
+			obj->atlased = false;
+			obj->unloaded = false;
+			_allLoaded = false;
+		}
+	});
+
+	for(auto& atlas : _atlases) {
+		if(_applyAtlas(data, *atlas)) {
+			break;
+		}
+	}
+
+	return data;
+}
+
+bool TextureDataHolder::_applyAtlas(TextureData& data, const TextureAtlas& atlas) {
+	if(auto* region = atlas.find(data.data->getName())) {
+		data.data->setAtlasRegion(atlas.getPage(region->page), region->position, region->size);
+		data.reloaded = true;
+		data.atlased = true;
+		data.unloaded = false;
+		return true;
+	}
+	return false;
+}
+
+void TextureDataHolder::loadAtlas(const std::string& path) {
+	for(auto& atlas : _atlases) {
+		if(atlas->getPath() == path) {
+			return;
+		}
+	}
+
+	auto atlas = std::make_unique<TextureAtlas>();
+	try {
+		atlas->loadFromFile(path);
+	}
+	catch(const std::exception& exc) {
+		LOG_EXCEPTION(exc);
+		return;
+	}
+	_addAtlas(std::move(atlas));
+}
+
+void TextureDataHolder::buildAtlas(glm::uvec2 pageSize) {
+	std::vector<std::string> files;
+	for(auto& obj : _data) {
+		if(!obj.atlased) {
+			files.push_back(obj.data->getName());
+		}
+	}
+
+	auto atlas = std::make_unique<TextureAtlas>(pageSize);
+	atlas->build(files);
+	_addAtlas(std::move(atlas));
+}
+
+void TextureDataHolder::_addAtlas(std::unique_ptr<TextureAtlas> atlas) {
+	atlas->upload();
+
+	size_t count = 0;
+	for(auto& obj : _data) {
+		if(!obj.atlased && _applyAtlas(obj, *atlas)) {
+			++count;
+		}
+	}
+	LOG_INFO("Atlas with ", atlas->getPagesCount(), " pages used by ", count, " textures");
+
+	_atlases.push_back(std::move(atlas));
+}
+
+size_t TextureDataHolder::getAtlasPagesCount() const {
+	size_t count = 0;
+	for(auto& atlas : _atlases) {
+		count += atlas->getPagesCount();
+	}
+	return count;
 }
 
 void TextureDataHolder::loadAll() {
@@ -76,7 +152,6 @@ void TextureDataHolder::loadAll() {
 		if(!obj.reloaded) {
 			obj.data->loadTexture();
 			obj.reloaded = true;
-			obj.updateTime();
 			std::cout<<"Loading textures: "<<i<<'/'<<size<<" | "<<obj.data->getName()<<std::endl;
 			// LOG_INFO("Loaded: ", obj.data->getName());
 		}
@@ -86,53 +161,160 @@ void TextureDataHolder::loadAll() {
 }
 
 void TextureDataHolder::loadAllInNewThread() {
+	PROFILE_FUNCTION();
 
-	if(_allLoaded) return;
-
-	//LOG_INFO("A");
-	if(_threadStatus == 0) {
-		//LOG_INFO("B");
-		_threadStatus = 1;
-		//LOG_INFO("C");
-		std::thread thread([&]{
-			int size = _data.size();
-			//LOG_INFO("E");
-			int i = 1;
-			//LOG_INFO("F");
+	// Queue textures requested since last call
+	if(!_allLoaded) {
+		_allLoaded = true;
+		_startWorkers();
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
 			for(auto& obj : _data) {
-				//LOG_INFO("G");
-				if(!obj.reloaded) {
-					//LOG_INFO("H");
-					obj.data->loadTextureWithoutSet();
-					//LOG_INFO("I");
-					std::cout<<"Loading textures: "<<i<<'/'<<size<<" | "<<obj.data->getName()<<std::endl;
-					//LOG_INFO("J");
+				if(!obj.reloaded && !obj.queued) {
+					obj.queued = true;
+					_decodeQueue.emplace_back(obj.data.get(), obj.data->getName());
+					++_pending;
+					++_requested;
 				}
-				++i;
 			}
-			_threadStatus = 2;
-		});
-		thread.join();
-		//LOG_INFO("K");
-	}
-	else if(_threadStatus == 2) {
-		//LOG_INFO("X1");
-		for(auto& obj : _data) {
-			//LOG_INFO("X2");
-			if(!obj.reloaded) {
-				//LOG_INFO("X3");
-				obj.data->setupSprite();
-				//LOG_INFO("X4");
-				obj.reloaded = true;
+		}
+		_condition.notify_all();
+	}
+
+	_releaseUnused();
+
+	if(_pending == 0) {
+		return;
+	}
+
+	// Upload decoded images, at least one per frame
+	const auto start = std::chrono::steady_clock::now();
+	const auto budget = std::chrono::duration<float, std::milli>(_uploadBudget);
+	do {
+		DecodedImage decoded;
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			if(_uploadQueue.empty()) {
+				break;
 			}
+			decoded = std::move(_uploadQueue.front());
+			_uploadQueue.pop_front();
+		}
+
+		auto* obj = find(decoded.data->getName());
+
+		// Texture could be packed in atlas while decoding
+		if(obj && obj->atlased) {
+			obj->queued = false;
+		}
+		else {
+			if(decoded.success) {
+				const auto size = decoded.image.getSize();
+				decoded.data->loadTexture(decoded.image.getPixelsPtr(), {size.x, size.y});
+			}
+			else {
+				LOG_ERROR("Cannot load texture from ", decoded.data->getName());
+			}
+
+			if(obj) {
+				obj->queued = false;
+				obj->reloaded = true;
+			}
+		}
+
+		--_pending;
+		++_loaded;
+	} while(std::chrono::steady_clock::now() - start < budget);
+
+	// Loading wave finished
+	if(_pending == 0) {
+		LOG_INFO("Textures loaded: ", _loaded);
+		_requested = 0;
+		_loaded = 0;
+	}
+}
+
+void TextureDataHolder::setUploadBudget(float milliseconds) {
+	_uploadBudget = milliseconds;
+}
+
+float TextureDataHolder::getUploadBudget() const {
+	return _uploadBudget;
+}
+
+size_t TextureDataHolder::getPendingCount() const {
+	return _pending;
+}
+
+float TextureDataHolder::getLoadingProgress() const {
+	if(_requested == 0) {
+		return 1.f;
+	}
+	return static_cast<float>(_loaded) / static_cast<float>(_requested);
+}
+
+bool TextureDataHolder::isLoading() const {
+	return _pending > 0 || !_allLoaded;
+}
+
+const sf3d::Texture& TextureDataHolder::_getPlaceholder() {
+	if(_placeholder.getID() == 0) {
+		// Translucent grey, so missing textures are visible but not disturbing
+		const glm::uvec2 size {64u, 64u};
+		std::vector<sf::Uint8> pixels(size.x * size.y * 4, 128);
+		for(size_t i = 3; i < pixels.size(); i += 4) {
+			pixels[i] = 64;
+		}
+		_placeholder.loadFromMemory(pixels.data(), size);
+	}
+	return _placeholder;
+}
+
+void TextureDataHolder::_startWorkers() {
+	if(!_workers.empty()) {
+		return;
+	}
+
+	// Leave one core for main thread
+	const unsigned count = std::clamp(std::thread::hardware_concurrency(), 2u, 5u) - 1;
+	for(unsigned i = 0; i < count; ++i) {
+		_workers.emplace_back(&TextureDataHolder::_workerLoop, this);
+	}
+}
+
+void TextureDataHolder::_workerLoop() {
+	Profiler::get().setThreadName("Texture decoder");
+
+	while(true) {
+		std::pair<SpriteDisplayData*, std::string> job;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_condition.wait(lock, [this] { return _stopWorkers || !_decodeQueue.empty(); });
+			if(_stopWorkers) {
+				return;
+			}
+			job = std::move(_decodeQueue.front());
+			_decodeQueue.pop_front();
+		}
+
+		// Decoding is the slow part, done without lock
+		DecodedImage decoded;
+		decoded.data = job.first;
+		{
+			PROFILE_SCOPE("Decode texture");
+			decoded.success = decoded.image.loadFromFile(job.second);
+		}
+
+		{
+			std::lock_guard<std::mutex> lock(_mutex);
+			_uploadQueue.push_back(std::move(decoded));
 		}
-		_threadStatus = 0;
-		_allLoaded = true;
 	}
 }
 
 TextureDataHolder::TextureData* TextureDataHolder::find(const std::string& filePath) {
-	for(auto& data : _data) {
+	if(auto it = _index.find(fnv1a_64(filePath.begin(), filePath.end())); it != _index.end()) {
+		auto& data = _data[it->second];
 		if(data.data->getName() == filePath) {
 			return &data;
 		}
@@ -140,10 +322,86 @@ TextureDataHolder::TextureData* TextureDataHolder::find(const std::string& fileP
 	return nullptr;
 }
 
+void TextureDataHolder::setMemoryBudget(size_t bytes) {
+	_memoryBudget = bytes;
+}
+
+size_t TextureDataHolder::getMemoryBudget() const {
+	return _memoryBudget;
+}
+
+size_t TextureDataHolder::getMemoryUsage() const {
+	return _memoryUsage;
+}
+
+void TextureDataHolder::_releaseUnused() {
+	++_frame;
+
+	// Update usage, request again textures which were unloaded but are drawn
+	_memoryUsage = 0;
+	for(auto& obj : _data) {
+		if(obj.data->takeUsed()) {
+			obj.lastUsedFrame = _frame;
+			if(obj.unloaded) {
+				obj.unloaded = false;
+				obj.reloaded = false;
+				_allLoaded = false;
+			}
+		}
+		_memoryUsage += obj.data->getMemorySize();
+	}
+
+	// Remove data which no one refers to for long time
+	for(size_t i = _data.size(); i-- > 0;) {
+		auto& obj = _data[i];
+		if(obj.data->getReferencesCount() == 0 && !obj.queued && _frame - obj.lastUsedFrame > _releaseDelay) {
+			const auto& name = obj.data->getName();
+			_index.erase(fnv1a_64(name.begin(), name.end()));
+			FileWatcher::get().unwatch(obj.watch);
+			_memoryUsage -= obj.data->getMemorySize();
+
+			if(i != _data.size() - 1) {
+				obj = std::move(_data.back());
+				const auto& movedName = obj.data->getName();
+				_index[fnv1a_64(movedName.begin(), movedName.end())] = i;
+			}
+			_data.pop_back();
+		}
+	}
+
+	if(_memoryUsage <= _memoryBudget) {
+		return;
+	}
+
+	// Unload least recently used textures, but not those drawn in last frames
+	std::vector<TextureData*> candidates;
+	for(auto& obj : _data) {
+		if(obj.data->isLoaded() && !obj.atlased && _frame - obj.lastUsedFrame > 1) {
+			candidates.push_back(&obj);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), [](const TextureData* a, const TextureData* b) {
+		return a->lastUsedFrame < b->lastUsedFrame;
+	});
+	for(auto* obj : candidates) {
+		if(_memoryUsage <= _memoryBudget) {
+			break;
+		}
+		_memoryUsage -= obj->data->getMemorySize();
+		obj->data->unloadTexture(_getPlaceholder());
+		obj->unloaded = true;
+	}
+}
+
 void TextureDataHolder::initScript(Script& script) {
 	auto object = script.newClass<TextureDataHolder>("TextureDataHolder", "World");
 
 	object.set("getData", &TextureDataHolder::getData);
+	object.set("getLoadingProgress", &TextureDataHolder::getLoadingProgress);
+	object.set("isLoading", &TextureDataHolder::isLoading);
+	object.set("getMemoryUsage", &TextureDataHolder::getMemoryUsage);
+	object.set("setMemoryBudget", &TextureDataHolder::setMemoryBudget);
+	object.set("loadAtlas", &TextureDataHolder::loadAtlas);
 
 	object.init();
 }
@@ -1,62 +1,159 @@
 #pragma once
 
 #include <vector>
+#include <deque>
+#include <unordered_map>
 #include <memory>
-#include <experimental/filesystem>
+#include <mutex>
+#include <thread>
+#include <condition_variable>
+
+#include <SFML/Graphics/Image.hpp>
 
 #include <Szczur/Utility/SFML3D/Texture.hpp>
+#include <Szczur/Utility/Convert/Hash.hpp>
 
 namespace rat {
 
 class SpriteDisplayData;
+class TextureAtlas;
 class Script;
 
-class TextureDataHolder 
+class TextureDataHolder
 {
 
 	struct TextureData {
 		std::unique_ptr<SpriteDisplayData> data;
 		bool reloaded = false;
-#ifndef PSYCHOX
-		std::experimental::filesystem::file_time_type lastWriten;
-#endif
+		bool queued = false;
+		bool unloaded = false;
+		bool atlased = false;
+		size_t lastUsedFrame = 0;
+		size_t watch = 0;
 
 		///
 		TextureData(SpriteDisplayData* data);
+	};
 
-		///
-		bool checkTime();
-
-		///
-		void updateTime();
+	/// Image decoded by worker, waiting for upload in main thread
+	struct DecodedImage {
+		SpriteDisplayData* data;
+		sf::Image image;
+		bool success;
 	};
 
 public:
 
-	/// Push texture to queue
-	const sf3d::Texture& getTexture(const std::string& filePath, bool reload = true);
+	///
+	TextureDataHolder();
+
+	///
+	TextureDataHolder(const TextureDataHolder&) = delete;
+
+	///
+	TextureDataHolder& operator = (const TextureDataHolder&) = delete;
 
-	/// Push texture to queue
-	SpriteDisplayData* getData(const std::string& filePath, bool reload = true);
+	///
+	~TextureDataHolder();
+
+	/// Push texture to queue, changed files are reloaded by file watcher
+	const sf3d::Texture& getTexture(const std::string& filePath);
+
+	/// Push texture to queue, returned data may be released at end of frame if no handle refers it
+	SpriteDisplayData* getData(const std::string& filePath);
 
 	/// Load all textures from queue
 	void loadAll();
 
-	/// NEED TO BE FIX!!! Load all textures from queue in new thread
+	/// Decodes queued textures in worker threads and uploads decoded ones within time budget, call once per frame
 	void loadAllInNewThread();
 
+	/// Time in milliseconds which can be spent on uploading textures in single frame
+	void setUploadBudget(float milliseconds);
+
+	///
+	float getUploadBudget() const;
+
+	/// Number of textures still decoding or waiting for upload
+	size_t getPendingCount() const;
+
+	/// Part of requested textures which are already loaded, in range [0, 1]
+	float getLoadingProgress() const;
+
+	///
+	bool isLoading() const;
+
+	/// Textures over this size in bytes are unloaded, starting from least recently used
+	void setMemoryBudget(size_t bytes);
+
+	///
+	size_t getMemoryBudget() const;
+
+	/// Estimated video memory taken by loaded textures
+	size_t getMemoryUsage() const;
+
+	/// Loads atlas written by `TextureAtlas::saveToFile`, its textures are used instead of separate ones
+	void loadAtlas(const std::string& path);
+
+	/// Packs all requested textures, which are not in atlas yet, into new atlas
+	void buildAtlas(glm::uvec2 pageSize = {4096u, 4096u});
+
+	///
+	size_t getAtlasPagesCount() const;
+
 	TextureData* find(const std::string& filePath);
 
 	static void initScript(Script& script);
 
 private:
 
+	///
+	const sf3d::Texture& _getPlaceholder();
+
+	///
+	TextureData& _add(const std::string& filePath);
+
+	/// Uses atlas region for data if atlas contains it
+	bool _applyAtlas(TextureData& data, const TextureAtlas& atlas);
+
+	///
+	void _addAtlas(std::unique_ptr<TextureAtlas> atlas);
+
+	/// Releases data without references and unloads textures over memory budget
+	void _releaseUnused();
+
+	///
+	void _startWorkers();
+
+	///
+	void _workerLoop();
 
 	/// pairs of data and isLoaded
 	std::vector<TextureData> _data;
+	std::unordered_map<Hash64_t, size_t> _index;
 	bool _allLoaded = true;
 
-	int _threadStatus = 0;
+	std::vector<std::unique_ptr<TextureAtlas>> _atlases;
+
+	// Releasing
+	size_t _frame = 0;
+	size_t _memoryUsage = 0;
+	size_t _memoryBudget = 512 * 1024 * 1024;
+	size_t _releaseDelay = 600;
+
+	// Streaming
+	sf3d::Texture _placeholder;
+	float _uploadBudget = 4.f;
+	size_t _pending = 0;
+	size_t _requested = 0;
+	size_t _loaded = 0;
+
+	std::vector<std::thread> _workers;
+	mutable std::mutex _mutex;
+	std::condition_variable _condition;
+	std::deque<std::pair<SpriteDisplayData*, std::string>> _decodeQueue;
+	std::deque<DecodedImage> _uploadQueue;
+	bool _stopWorkers = false;
 };
 
-}
\ No newline at end of file
+}
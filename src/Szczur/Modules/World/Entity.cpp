@@ -27,6 +27,7 @@ Entity::Entity(const Entity& rhs)
 	{
 		_holder.emplace_back(ptr->copy(this));
 	}
+	_updateSlots();
 	_scriptData = rhs._scriptData;
 }
 
@@ -35,10 +36,18 @@ Entity& Entity::operator = (const Entity& rhs)
 	if (this != &rhs)
 	{
 		static_cast<sf3d::Transformable&>(*this) = static_cast<const sf3d::Transformable&>(rhs);
+		// Entity may be not added yet, then it stays out of indices of new parent too
+		const bool indexed = _parent && _parent->getEntity(_id) == this;
+		if (indexed) {
+			_parent->_unindexEntity(this);
+		}
 		_id = getUniqueID<Entity>();
 		_group = rhs.getGroup();
 		_name = rhs.getName() + "_copy_" + std::to_string(_id);
 		_parent = rhs._parent;
+		if (indexed && _parent) {
+			_parent->_indexEntity(this);
+		}
 
 		removeAllComponents();
 
@@ -46,30 +55,12 @@ Entity& Entity::operator = (const Entity& rhs)
 		{
 			_holder.emplace_back(ptr->copy(this));
 		}
+		_updateSlots();
 	}
 
 	return *this;
 }
 
-void Entity::update(ScenesManager& scenes, float deltaTime)
-{
-	if (_isActive) {
-		if(auto* comp = getComponentAs<InteractableComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<TraceComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<CameraComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<TriggerComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<ArmatureComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<AnimatedSpriteComponent>()) comp->update(scenes, deltaTime);
-		if(auto* comp = getComponentAs<SpriteComponent>()) comp->update(scenes, deltaTime);
-
-		if(auto* comp = getComponentAs<ScriptableComponent>()) {  
-			if(getScene()->getScenes()->isGameRunning()) { 
-				comp->update(scenes, deltaTime); 
-			} 
-		} 
-	}
-}
-
 void Entity::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 {
 	if (_isVisible) {
@@ -83,8 +74,25 @@ void Entity::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 	}
 }
 
+bool Entity::getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const
+{
+	// Trace lines are drawn along whole path
+	if (hasComponent<TraceComponent>()) {
+		return false;
+	}
+
+	if (const Component* component = _featureSlots[_getFeatureSlot(Component::Drawable)]) {
+		return component->getWorldBounds(boundsMin, boundsMax);
+	}
+	return false;
+}
+
 void Entity::destroy()
 {
+	// Entity is removed by scene at the end of update
+	if (_exists && _parent) {
+		_parent->_queueDestruction(this);
+	}
 	_exists = false;
 }
 
@@ -125,7 +133,11 @@ const std::string& Entity::getGroup() const
 
 void Entity::setName(const std::string& name)
 {
+	const std::string oldName = std::move(_name);
 	_name = name;
+	if (_parent) {
+		_parent->_onEntityRenamed(this, oldName);
+	}
 }
 
 const std::string& Entity::getName() const
@@ -152,7 +164,9 @@ Component* Entity::addComponent(std::unique_ptr<Component> component)
 		return ptr;
 	}
 
-	return _holder.emplace_back(std::move(component)).get();
+	auto* added = _holder.emplace_back(std::move(component)).get();
+	_updateSlots();
+	return added;
 }
 
 Component* Entity::addComponent(Hash64_t componentID)
@@ -165,6 +179,7 @@ bool Entity::removeComponent(Hash64_t componentID)
 	if (auto it = _findByComponentID(componentID); it != _holder.end())
 	{
 		_holder.erase(it);
+		_updateSlots();
 
 		return true;
 	}
@@ -175,13 +190,14 @@ bool Entity::removeComponent(Hash64_t componentID)
 void Entity::removeAllComponents()
 {
 	_holder.clear();
+	_updateSlots();
 }
 
 Component* Entity::getComponent(Hash64_t componentID) const
 {
-	if (auto it = _findByComponentID(componentID); it != _holder.end())
+	if (const size_t slot = ComponentTraits::getSlotFromIdentifier(componentID); slot < _slots.size())
 	{
-		return it->get();
+		return _slots[slot];
 	}
 
 	return nullptr;
@@ -189,7 +205,7 @@ Component* Entity::getComponent(Hash64_t componentID) const
 
 bool Entity::hasComponent(Hash64_t componentID) const
 {
-	return _findByComponentID(componentID) != _holder.end();
+	return getComponent(componentID) != nullptr;
 }
 
 Entity::ComponentsHolder_t& Entity::getComponents()
@@ -204,8 +220,14 @@ const Entity::ComponentsHolder_t& Entity::getComponents() const
 
 void Entity::loadFromConfig(Json& config, bool withNewID)
 {
+	const size_t oldID = _id;
+	const std::string oldName = _name;
 	_id = withNewID ? getUniqueID<Entity>() : config["id"].get<size_t>();
 	_name = config["name"].get<std::string>();
+	if (_parent) {
+		_parent->_onEntityIDChanged(this, oldID);
+		_parent->_onEntityRenamed(this, oldName);
+	}
 
 	setPosition({
 		config["position"]["x"].get<float>(),
@@ -237,6 +259,9 @@ void Entity::loadFromConfig(Json& config, bool withNewID)
 		addComponent(static_cast<Hash64_t>(component["id"]))->loadFromConfig(component);
 	}
 
+	// Loaded components may have other features
+	_updateSlots();
+
 	if (base == false) {         
         addComponent<BaseComponent>(); 
     } 
@@ -297,7 +322,11 @@ void Entity::initScript(Script& script)
 
 void Entity::updateIDs()
 {
+	const size_t oldID = _id;
 	_id = getUniqueID<Entity>();
+	if (_parent) {
+		_parent->_onEntityIDChanged(this, oldID);
+	}
 
 	for (const auto& component : _holder)
 	{
@@ -319,18 +348,26 @@ typename Entity::ComponentsHolder_t::const_iterator Entity::_findByComponentID(s
 	});
 }
 
-typename Entity::ComponentsHolder_t::iterator Entity::_findByFeature(Component::Feature_e feature)
+void Entity::_updateSlots()
 {
-	return std::find_if(_holder.begin(), _holder.end(), [=](const auto& arg) {
-		return arg->getFeatures() & feature;
-	});
-}
+	_slots.fill(nullptr);
+	_featureSlots.fill(nullptr);
 
-typename Entity::ComponentsHolder_t::const_iterator Entity::_findByFeature(Component::Feature_e feature) const
-{
-	return std::find_if(_holder.begin(), _holder.end(), [=](const auto& arg) {
-		return arg->getFeatures() & feature;
-	});
+	for (const auto& component : _holder)
+	{
+		if (const size_t slot = ComponentTraits::getSlotFromIdentifier(component->getComponentID()); slot < _slots.size())
+		{
+			_slots[slot] = component.get();
+		}
+
+		for (size_t i = 0; i < _featureSlots.size(); ++i)
+		{
+			if (!_featureSlots[i] && (component->getFeatures() & (size_t(1) << i)))
+			{
+				_featureSlots[i] = component.get();
+			}
+		}
+	}
 }
 
 void Entity::_setScriptDataObject(std::string key, sol::stack_object value) {
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <array>
 #include <unordered_map>
 
 #include "Szczur/Modules/Script/Script.hpp"
@@ -41,13 +42,13 @@ public:
 	///
 	virtual ~Entity() = default;
 
-	///
-	void update(ScenesManager& scenes, float deltaTime);
-
 	///
 	virtual void draw(sf3d::RenderTarget& target, sf3d::RenderStates states = sf3d::RenderStates::Default) const override;
 
-	/// removes object
+	/// Bounds of drawn component in world space, false if entity should never be culled
+	bool getWorldBounds(glm::vec3& boundsMin, glm::vec3& boundsMax) const;
+
+	/// Marks entity to be removed at the end of scene update
 	void destroy();
 
 	/// check if object is still exist
@@ -119,14 +120,14 @@ public:
 	template <typename T>
 	Component* getComponent() const
 	{
-		return getComponent(ComponentTraits::getIdentifierFromType<T>());
+		return _slots[ComponentTraits::getSlotFromType<T>()];
 	}
 
 	///
 	template <typename T>
 	T* getComponentAs() const
 	{
-		return static_cast<T*>(getComponent(ComponentTraits::getIdentifierFromType<T>()));
+		return static_cast<T*>(_slots[ComponentTraits::getSlotFromType<T>()]);
 	}
 
 	///
@@ -135,9 +136,9 @@ public:
 	{
 		auto feature = ComponentTraits::getFeatureFromType<T>();
 
-		if (auto it = _findByFeature(feature); it != _holder.end())
+		if (auto* component = _featureSlots[_getFeatureSlot(feature)])
 		{
-			return static_cast<T*>(it->get()->getFeature(feature));
+			return static_cast<T*>(component->getFeature(feature));
 		}
 
 		return nullptr;
@@ -149,9 +150,9 @@ public:
 	{
 		auto feature = ComponentTraits::getFeatureFromType<T>();
 
-		if (auto it = _findByFeature(feature); it != _holder.end())
+		if (const auto* component = _featureSlots[_getFeatureSlot(feature)])
 		{
-			return static_cast<const T*>(it->get()->getFeature(feature));
+			return static_cast<const T*>(component->getFeature(feature));
 		}
 
 		return nullptr;
@@ -164,7 +165,7 @@ public:
 	template <typename T>
 	bool hasComponent() const
 	{
-		return hasComponent(ComponentTraits::getIdentifierFromType<T>());
+		return getComponent<T>() != nullptr;
 	}
 
 	///
@@ -193,11 +194,16 @@ private:
 	///
 	typename ComponentsHolder_t::const_iterator _findByComponentID(size_t id) const;
 
-	///
-	typename ComponentsHolder_t::iterator _findByFeature(Component::Feature_e feature);
+	/// Fills slots from holder, must be called after components are added, removed or loaded
+	void _updateSlots();
 
 	///
-	typename ComponentsHolder_t::const_iterator _findByFeature(Component::Feature_e feature) const;
+	static size_t _getFeatureSlot(Component::Feature_e feature)
+	{
+		size_t slot = 0;
+		while ((size_t(1) << slot) < static_cast<size_t>(feature)) ++slot;
+		return slot;
+	}
 
 	///
 	void _setScriptDataObject(std::string key, sol::stack_object value);
@@ -220,6 +226,12 @@ private:
 	std::string _name;
 	Scene* _parent;
 	ComponentsHolder_t _holder;
+
+	/// Components by type, so lookups do not scan holder
+	std::array<Component*, ComponentTraits::ComponentsCount> _slots {};
+
+	/// First component with given feature bit
+	std::array<Component*, Component::FeaturesCount> _featureSlots {};
 };
 
 }
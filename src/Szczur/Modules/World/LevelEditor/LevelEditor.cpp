@@ -96,11 +96,14 @@ namespace rat {
 			if(_ifRenderDialogEditor) _dialogEditor->update();
 			if(_ifRenderAudioEditor) _audioEditor->render();
 			if(_ifRenderReloader) _renderReloader();
+			if(_ifRenderRenderStatistics) _renderRenderStatistics(target);
+			if(_ifRenderProfiler) _renderProfiler();
 			
 
 			scene = _scenes.getCurrentScene();
 			
 			_renderOrigins(target);
+			if(_ifRenderCullingBounds) _renderCullingBounds(target);
 		}
 
 		if (_isGroupSelecting) {
@@ -118,7 +121,7 @@ namespace rat {
 
 		// Find selected camera
 		Entity* cameraEntity = nullptr;
-		for (auto& entity : scene->getEntities("single")) { 
+		for (auto& entity : scene->getEntities(Scene::Single)) { 
 			if (auto* comp = entity->getComponentAs<CameraComponent>()) { 
 				if (_objectsList.getSelectedID() == entity->getID() || comp->getLock()) { 
 					cameraEntity = entity.get(); 
@@ -137,7 +140,7 @@ namespace rat {
 		Entity* cameraEntity = nullptr;
 		
 		// Find selected camera
-		for (auto& entity : scene->getEntities("single")) { 
+		for (auto& entity : scene->getEntities(Scene::Single)) { 
 			if (auto* comp = entity->getComponentAs<CameraComponent>()) { 
 				if (_objectsList.getSelectedID() == entity->getID() || comp->getLock()) { 
 					cameraEntity = entity.get(); 
@@ -480,7 +483,7 @@ namespace rat {
 	void LevelEditor::changeCameraLock()
 	{
 		auto* scene = _scenes.getCurrentScene();
-		for (auto& entity : scene->getEntities("single")) { 
+		for (auto& entity : scene->getEntities(Scene::Single)) { 
 			if (auto* comp = entity->getComponentAs<CameraComponent>()) { 
 				comp->setLock(!comp->getLock()); 
 				comp->setNoMove(comp->getLock()); 
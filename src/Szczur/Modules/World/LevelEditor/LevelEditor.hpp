@@ -142,6 +142,15 @@ private:
 	///
 	void _renderReloader();
 
+	///
+	void _renderRenderStatistics(sf3d::RenderTarget& target);
+
+	/// Draws world bounds used by culling, green when entity is drawn and red when culled
+	void _renderCullingBounds(sf3d::RenderTarget& target);
+
+	///
+	void _renderProfiler();
+
 private:
 
 // Select fix
@@ -190,6 +199,18 @@ private:
 	bool _ifRenderProperties{false};
 	bool _ifShowImGuiDemoWindow{false};
 	bool _ifRenderReloader{false};
+	bool _ifRenderRenderStatistics{false};
+	bool _ifRenderProfiler{false};
+	bool _ifRenderCullingBounds{false};
+
+// Profiler
+
+	/// Begin and end of frames shown in profiler, oldest first
+	std::vector<std::pair<std::uint64_t, std::uint64_t>> _profilerFrames;
+	int _profilerFrame{0};
+	float _profilerZoom{1.f};
+	bool _profilerPaused{false};
+	int _profilerWorkers{-1};
 
 // Clipboard
 
@@ -1,5 +1,7 @@
 #include "LevelEditor.hpp"
 
+#include <algorithm>
+#include <cstdio>
 #include <experimental/filesystem>
 
 #include "Szczur/Modules/FileSystem/FileDialog.hpp"
@@ -9,6 +11,10 @@
 #include <Szczur/Modules/Equipment/Equipment.hpp>
 
 #include <Szczur/ImGuiStyler.hpp>
+#include <Szczur/Utility/FileWatcher.hpp>
+#include <Szczur/Utility/JobSystem.hpp>
+#include <Szczur/Utility/Profiler.hpp>
+#include <Szczur/Utility/Convert/Hash.hpp>
 
 #include <imgui.h>
 
@@ -139,6 +145,17 @@ namespace rat {
 					}
 				}
 				
+				if(ImGui::MenuItem("Build texture atlas", nullptr, false, _scenes.currentFilePath != "")) {
+					try {
+						_scenes.buildAtlas(_scenes.currentFilePath);
+						printMenuBarInfo(std::string("Texture atlas built for: ") + _scenes.currentFilePath);
+					}
+					catch (const std::exception& exc)
+					{
+						LOG_EXCEPTION(exc);
+					}
+				}
+				
 				if (ImGui::MenuItem("Show in explorer")) {
 					std::string current = std::experimental::filesystem::current_path().string();
 
@@ -166,6 +183,8 @@ namespace rat {
 				ImGui::MenuItem("Dialog Editor", nullptr, &_ifRenderDialogEditor);
 				ImGui::MenuItem("Audio Editor", nullptr, &_ifRenderAudioEditor);
 				ImGui::MenuItem("Reloader", nullptr, &_ifRenderReloader);
+				ImGui::MenuItem("Render statistics", nullptr, &_ifRenderRenderStatistics);
+				ImGui::MenuItem("Profiler", nullptr, &_ifRenderProfiler);
 				ImGui::EndMenu();
 			}
 
@@ -279,6 +298,179 @@ namespace rat {
 			if (ImGui::Selectable("Reload##equipment_items")) {
 				detail::globalPtr<Equipment>->reloadItemsList();
 			}
+
+			// Textures, shaders, scripts and armatures are reloaded automatically
+			ImGui::Separator();
+			ImGui::Text("Watched files: %u", static_cast<unsigned>(FileWatcher::get().getWatchesCount()));
+		}
+		ImGui::End();
+	}
+
+	void LevelEditor::_renderRenderStatistics(sf3d::RenderTarget& target)
+	{
+		if (ImGui::Begin("Render statistics##tool", &_ifRenderRenderStatistics, ImGuiWindowFlags_AlwaysAutoResize)) {
+			const auto& statistics = target.getStatistics();
+			ImGui::Text("Draw calls: %u", static_cast<unsigned>(statistics.drawCalls));
+			ImGui::Text("Batches: %u", static_cast<unsigned>(statistics.batches));
+			ImGui::Text("Batched draws: %u", static_cast<unsigned>(statistics.batchedDraws));
+			ImGui::Text("Batched vertices: %u", static_cast<unsigned>(statistics.batchedVertices));
+			ImGui::Text("Batched indices: %u", static_cast<unsigned>(statistics.batchedIndices));
+			ImGui::Text("Applied lights: %u", static_cast<unsigned>(statistics.appliedLights));
+			ImGui::Text("Texture changes: %u", static_cast<unsigned>(statistics.textureChanges));
+
+			const auto& culling = _scenes.getCurrentScene()->getCullingStatistics();
+			ImGui::Text("Culled entities: %u / %u", static_cast<unsigned>(culling.culled), static_cast<unsigned>(culling.tested));
+
+			auto& textures = _scenes.getTextureDataHolder();
+			ImGui::Text("Atlas pages: %u", static_cast<unsigned>(textures.getAtlasPagesCount()));
+			ImGui::Text("Texture memory: %.1f MB", textures.getMemoryUsage() / (1024.f * 1024.f));
+
+			bool batching = target.isBatchingEnabled();
+			if (ImGui::Checkbox("Batching##render_statistics", &batching)) {
+				target.setBatchingEnabled(batching);
+			}
+
+			bool cullingEnabled = _scenes.isCullingEnabled();
+			if (ImGui::Checkbox("Culling##render_statistics", &cullingEnabled)) {
+				_scenes.setCullingEnabled(cullingEnabled);
+			}
+			ImGui::SameLine();
+			ImGui::Checkbox("Show bounds##render_statistics", &_ifRenderCullingBounds);
+
+			int maxLights = static_cast<int>(target.getMaxLightPointsPerObject());
+			if (ImGui::SliderInt("Max lights per object##render_statistics", &maxLights, 0, static_cast<int>(sf3d::RenderTarget::maxLightPointsPerObjectLimit))) {
+				target.setMaxLightPointsPerObject(static_cast<std::size_t>(maxLights));
+			}
+		}
+		ImGui::End();
+	}
+
+	void LevelEditor::_renderProfiler()
+	{
+		auto& profiler = Profiler::get();
+
+		if (ImGui::Begin("Profiler##tool", &_ifRenderProfiler)) {
+			bool enabled = profiler.isEnabled();
+			if (ImGui::Checkbox("Enabled##profiler", &enabled)) {
+				profiler.setEnabled(enabled);
+			}
+			ImGui::SameLine();
+			ImGui::Checkbox("Pause##profiler", &_profilerPaused);
+			ImGui::SameLine();
+			if (ImGui::Button("Save Chrome trace##profiler")) {
+				if (auto path = FileDialog::getSaveFileName("Save Chrome trace", "", "Chrome trace (*.json)|*.json"); !path.empty()) {
+					try {
+						profiler.saveChromeTrace(path);
+					}
+					catch (const std::exception& exc) {
+						LOG_EXCEPTION(exc);
+					}
+				}
+			}
+
+			// Worker threads show up in timeline, deterministic mode runs all jobs in order on main thread
+			auto& jobs = JobSystem::get();
+			if (_profilerWorkers < 0) {
+				_profilerWorkers = static_cast<int>(jobs.getWorkersCount());
+			}
+			ImGui::PushItemWidth(120.f);
+			ImGui::InputInt("Workers##profiler", &_profilerWorkers);
+			ImGui::PopItemWidth();
+			_profilerWorkers = std::clamp(_profilerWorkers, 0, 64);
+
+			// Workers are restarted once for edited count, not on every step of input
+			if (static_cast<size_t>(_profilerWorkers) != jobs.getWorkersCount()) {
+				ImGui::SameLine();
+				if (ImGui::Button("Apply##profiler_workers")) {
+					jobs.setWorkersCount(static_cast<size_t>(_profilerWorkers));
+				}
+			}
+			ImGui::SameLine();
+			bool deterministic = jobs.isDeterministic();
+			if (ImGui::Checkbox("Deterministic jobs##profiler", &deterministic)) {
+				jobs.setDeterministic(deterministic);
+			}
+
+			// Paused history stays, zones are taken from ring buffers as long as they are not overwritten
+			if (!_profilerPaused) {
+				_profilerFrames.resize(profiler.getFramesCount());
+				for (size_t i = 0; i < _profilerFrames.size(); ++i) {
+					_profilerFrames[i] = profiler.getFrame(_profilerFrames.size() - 1 - i);
+				}
+			}
+
+			if (!_profilerFrames.empty()) {
+				const int framesCount = static_cast<int>(_profilerFrames.size());
+
+				std::vector<float> times(_profilerFrames.size());
+				for (size_t i = 0; i < times.size(); ++i) {
+					times[i] = (_profilerFrames[i].second - _profilerFrames[i].first) / 1000000.f;
+				}
+				const int worst = static_cast<int>(std::max_element(times.begin(), times.end()) - times.begin());
+
+				// Clicked bar selects frame
+				char overlay[32];
+				std::snprintf(overlay, sizeof(overlay), "Worst: %.2f ms", times[worst]);
+				ImGui::PlotHistogram("##profiler_frames", times.data(), framesCount, 0, overlay, 0.f, times[worst], ImVec2(ImGui::GetContentRegionAvail().x, 60.f));
+				if (ImGui::IsItemClicked()) {
+					const ImVec2 min = ImGui::GetItemRectMin();
+					const ImVec2 max = ImGui::GetItemRectMax();
+					const int index = static_cast<int>((ImGui::GetIO().MousePos.x - min.x) / (max.x - min.x) * framesCount);
+					_profilerFrame = framesCount - 1 - index;
+				}
+
+				ImGui::SliderInt("Frames ago##profiler", &_profilerFrame, 0, framesCount - 1);
+				ImGui::SameLine();
+				if (ImGui::Button("Worst##profiler")) {
+					_profilerFrame = framesCount - 1 - worst;
+				}
+				_profilerFrame = std::clamp(_profilerFrame, 0, framesCount - 1);
+
+				ImGui::SliderFloat("Zoom##profiler", &_profilerZoom, 1.f, 50.f, "%.1fx", 2.f);
+
+				const auto [frameBegin, frameEnd] = _profilerFrames[framesCount - 1 - _profilerFrame];
+				ImGui::Text("Frame: %.2f ms", (frameEnd - frameBegin) / 1000000.f);
+
+				// Timeline, nested zones are drawn in rows below their parents
+				ImGui::BeginChild("##profiler_timeline", ImVec2(0.f, 0.f), true, ImGuiWindowFlags_HorizontalScrollbar);
+				auto* drawList = ImGui::GetWindowDrawList();
+				const float rowHeight = ImGui::GetTextLineHeightWithSpacing();
+				const float width = std::max(ImGui::GetContentRegionAvail().x * _profilerZoom, 1.f);
+				const double scale = width / static_cast<double>(std::max<std::uint64_t>(frameEnd - frameBegin, 1));
+
+				for (auto& thread : profiler.collect(frameBegin, frameEnd)) {
+					if (thread.zones.empty()) {
+						continue;
+					}
+					ImGui::Text("%s", thread.name.c_str());
+
+					const ImVec2 origin = ImGui::GetCursorScreenPos();
+					std::uint32_t maxDepth = 0;
+					for (auto& zone : thread.zones) {
+						maxDepth = std::max(maxDepth, zone.depth);
+
+						const float x0 = origin.x + static_cast<float>((std::max(zone.begin, frameBegin) - frameBegin) * scale);
+						const float x1 = origin.x + static_cast<float>((std::min(zone.end, frameEnd) - frameBegin) * scale);
+						const ImVec2 min { x0, origin.y + zone.depth * rowHeight };
+						const ImVec2 max { std::max(x1, x0 + 1.f), min.y + rowHeight - 1.f };
+
+						// Same zone has same color in every frame
+						const auto hash = fnv1a_32(zone.name);
+						drawList->AddRectFilled(min, max, IM_COL32(64 + hash % 128, 64 + (hash >> 8) % 128, 64 + (hash >> 16) % 128, 255));
+						if (max.x - min.x > 20.f) {
+							drawList->PushClipRect(min, max, true);
+							drawList->AddText(ImVec2(min.x + 2.f, min.y), IM_COL32_WHITE, zone.name);
+							drawList->PopClipRect();
+						}
+
+						if (ImGui::IsMouseHoveringRect(min, max)) {
+							ImGui::SetTooltip("%s\n%.3f ms", zone.name, (zone.end - zone.begin) / 1000000.f);
+						}
+					}
+					ImGui::Dummy(ImVec2(width, (maxDepth + 1) * rowHeight));
+				}
+				ImGui::EndChild();
+			}
 		}
 		ImGui::End();
 	}
@@ -76,6 +76,28 @@ namespace rat {
 		}
 	}
 
+	void LevelEditor::_renderCullingBounds(sf3d::RenderTarget& target) {
+		const sf3d::Frustum frustum = target.getViewFrustum();
+
+		sf3d::RectangleShape rect;
+
+		_scenes.getCurrentScene()->forEach([&](const std::string& group, Entity& entity){
+			glm::vec3 boundsMin;
+			glm::vec3 boundsMax;
+			if(!entity.isVisible() || !entity.getWorldBounds(boundsMin, boundsMax))
+				return;
+
+			// Rectangle goes down from its position, like sprites
+			rect.setPosition({boundsMin.x, boundsMax.y, boundsMax.z});
+			rect.setSize({boundsMax.x - boundsMin.x, boundsMax.y - boundsMin.y});
+			if(frustum.intersects(boundsMin, boundsMax))
+				rect.setColor({0.f, 1.f, 0.f, 0.15f});
+			else
+				rect.setColor({1.f, 0.f, 0.f, 0.15f});
+			target.draw(rect);
+		});
+	}
+
 	void LevelEditor::_renderOrigins(sf3d::RenderTarget& target) {
 
 		if (_objectsList.isGroupSelected())
@@ -85,7 +107,7 @@ namespace rat {
 		}
 
 		// Render origins for background group
-		for(auto& entity : _scenes.getCurrentScene()->getEntities("background")) {
+		for(auto& entity : _scenes.getCurrentScene()->getEntities(Scene::Background)) {
 			if(_objectsList.isEntitySelected(entity.get())) {
 				_renderOriginRectangle(entity->getPosition(), true, target);
 			}
@@ -95,7 +117,7 @@ namespace rat {
 		}
 
 		// Render origins for path group
-		for(auto& entity : _scenes.getCurrentScene()->getEntities("path")) {			
+		for(auto& entity : _scenes.getCurrentScene()->getEntities(Scene::Path)) {			
 			if (_objectsList.isEntitySelected(entity.get())) {
 				_renderOriginRectangle(entity->getPosition(), true, target);
 			}
@@ -105,7 +127,7 @@ namespace rat {
 		}
 
 		// Render origins for foreground group
-		for(auto& entity : _scenes.getCurrentScene()->getEntities("foreground")) {			
+		for(auto& entity : _scenes.getCurrentScene()->getEntities(Scene::Foreground)) {			
 			if (_objectsList.isEntitySelected(entity.get())) {
 				_renderOriginRectangle(entity->getPosition(), true, target);
 			}
@@ -115,7 +137,7 @@ namespace rat {
 		}
 
 		// Render origins for single group
-		for(auto& entity : _scenes.getCurrentScene()->getEntities("single")) {			
+		for(auto& entity : _scenes.getCurrentScene()->getEntities(Scene::Single)) {			
 			if (_objectsList.isEntitySelected(entity.get())) {
 				if(auto* camera = entity->getComponentAs<CameraComponent>(); camera == nullptr) {
 					_renderOriginRectangle(entity->getPosition(), true, target);
@@ -127,7 +149,7 @@ namespace rat {
 		}
 
 		// Render origins for entries group
-		for(auto& entity : _scenes.getCurrentScene()->getEntities("entries")) {			
+		for(auto& entity : _scenes.getCurrentScene()->getEntities(Scene::Entries)) {			
 			if (_objectsList.isEntitySelected(entity.get())) {
 				_renderOriginCircle(entity->getPosition(), true, target);
 			}
@@ -1,8 +1,12 @@
 #include "ScenesManager.hpp"
 
+#include <algorithm>
 #include <functional>
+#include <iterator>
 
+#include "Szczur/Utility/JobSystem.hpp"
 #include "Szczur/Utility/Logger.hpp"
+#include "Szczur/Utility/Profiler.hpp"
 #include "Szczur/Utility/SFML3D/Drawable.hpp"
 #include "Szczur/Utility/SFML3D/Sprite.hpp"
 #include "Szczur/Utility/SFML3D/Texture.hpp"
@@ -19,6 +23,8 @@
 
 #include "UniqueID.hpp"
 
+#include "Szczur/Utility/Convert/Hash.hpp"
+
 namespace rat
 {
 
@@ -26,6 +32,7 @@ Scene::Scene(ScenesManager* parent)
 	: _id { getUniqueID<Scene>() }
 	, _name { "unnamed_" + std::to_string(_id) }
 	, _parent { parent }
+	, _triggers { this }
 {
 	_collectingHolder.emplace_back("background", EntitiesHolder_t{}); 
 	_collectingHolder.emplace_back("single", EntitiesHolder_t{});
@@ -44,29 +51,139 @@ Scene::Scene(ScenesManager* parent)
 
 void Scene::update(float deltaTime)
 {
-	_parent->getTextureDataHolder().loadAll();
-	for (auto& holder : getAllEntities())
+	PROFILE_FUNCTION();
+
+	_parent->getTextureDataHolder().loadAllInNewThread();
+
+	_updateSpatialHash();
+
+	// Found on main thread, thread-safe passes only read current camera
+	getCamera();
+
+	// Components are updated by type, walking their pools in memory order. Types which are not
+	// thread-safe, like Lua calls and DragonBones armatures with global event pools, stay on main thread
+	_updateInteractions();
+	_updatePass<TraceComponent>(deltaTime);
+	_updatePass<CameraComponent>(deltaTime);
+	if (getScenes()->isGameRunning())
 	{
-		for (auto& entity : holder.second)
-		{
-			if (entity->exists())
+		_triggers.update();
+	}
+	_updatePass<ArmatureComponent>(deltaTime);
+	_updatePass<AnimatedSpriteComponent>(deltaTime);
+	_updatePass<SpriteComponent>(deltaTime);
+	if (getScenes()->isGameRunning())
+	{
+		_updatePass<ScriptableComponent>(deltaTime);
+	}
+
+	removeDestroyedEntities();
+
+	if (Entity* cameraEntity = getCamera()) {
+		cameraEntity->getComponentAs<CameraComponent>()->updateCamera();
+	}
+}
+
+template <typename T>
+void Scene::_updatePass(float deltaTime)
+{
+	PROFILE_FUNCTION();
+
+	auto& scenes = *getScenes();
+	auto isUpdated = [this](T& component) {
+		// Pool is shared by all scenes
+		Entity* entity = component.getEntity();
+		return entity->getScene() == this && entity->exists() && entity->isActive();
+	};
+
+	if constexpr (T::ThreadSafeUpdate)
+	{
+		// Components per job, small enough to balance uneven work
+		constexpr size_t grain = 128;
+
+		_parallelComponents.clear();
+		ComponentPool<T>::get().forEach([&](T& component) {
+			if (isUpdated(component))
+			{
+				_parallelComponents.push_back(&component);
+			}
+		});
+
+		JobSystem::get().parallelFor(_parallelComponents.size(), grain, [&](size_t begin, size_t end) {
+			PROFILE_SCOPE("Scene::_updatePass job");
+			for (size_t i = begin; i < end; ++i)
 			{
-				entity->update(*getScenes(), deltaTime);
+				static_cast<T*>(_parallelComponents[i])->update(scenes, deltaTime);
 			}
-			else
+		});
+	}
+	else
+	{
+		ComponentPool<T>::get().forEach([&](T& component) {
+			if (isUpdated(component))
 			{
-				removeEntity(holder.first, entity->getID());
+				component.update(scenes, deltaTime);
 			}
+		});
+	}
+}
+
+void Scene::_updateSpatialHash()
+{
+	PROFILE_FUNCTION();
+
+	ComponentPool<ColliderComponent>::get().forEach([this](ColliderComponent& collider) {
+		if (collider.getEntity()->getScene() == this)
+		{
+			collider.updateSpatialHash();
+		}
+	});
+	ComponentPool<TriggerComponent>::get().forEach([this](TriggerComponent& trigger) {
+		if (trigger.getEntity()->getScene() == this)
+		{
+			trigger.updateSpatialHash();
+		}
+	});
+	ComponentPool<InteractableComponent>::get().forEach([this](InteractableComponent& interactable) {
+		if (interactable.getEntity()->getScene() == this)
+		{
+			interactable.updateSpatialHash();
 		}
+	});
+}
+
+void Scene::_updateInteractions()
+{
+	PROFILE_FUNCTION();
+
+	Entity* player = getPlayer();
+	if (player == nullptr || !detail::globalPtr<Input>->getManager().isReleased(Keyboard::LShift))
+	{
+		return;
 	}
 
-	if (Entity* cameraEntity = getCamera()) {
-		cameraEntity->getComponentAs<CameraComponent>()->updateCamera();
+	const glm::vec3 position = player->getPosition();
+	std::vector<InteractableComponent*> interactables;
+	_spatialHash.query({ position.x, position.z, position.x, position.z }, SpatialHash::Interactables, [&](Component* component) {
+		auto* interactable = static_cast<InteractableComponent*>(component);
+		Entity* entity = interactable->getEntity();
+		if (entity->exists() && entity->isActive() && interactable->checkForInteraction(position))
+		{
+			interactables.push_back(interactable);
+		}
+	});
+
+	// Callbacks may add or remove components, so they are called after query
+	for (auto* interactable : interactables)
+	{
+		interactable->callback();
 	}
 }
 
 void Scene::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 {
+	PROFILE_FUNCTION();
+
 	// Register light components to shader
 	target.resetLightPoints();
 	for (auto& holder : this->getAllEntities()) {
@@ -80,12 +197,80 @@ void Scene::draw(sf3d::RenderTarget& target, sf3d::RenderStates states) const
 		}
 	}
 	
-	// Draw the entites
+	// Entities outside of camera view volume are skipped
+	const bool culling = getScenes()->isCullingEnabled();
+	const sf3d::Frustum frustum = target.getViewFrustum();
+	_cullingStatistics = CullingStatistics();
+
+	// Draw the entites, merging sprites which share texture
+	target.beginBatch();
 	for (auto& holder : this->getAllEntities()) {
 		for (auto& entity : holder.second) {
+			if (culling && entity->isVisible()) {
+				glm::vec3 boundsMin;
+				glm::vec3 boundsMax;
+				if (entity->getWorldBounds(boundsMin, boundsMax)) {
+					++_cullingStatistics.tested;
+					if (!frustum.intersects(boundsMin, boundsMax)) {
+						++_cullingStatistics.culled;
+						continue;
+					}
+				}
+			}
 			entity->draw(target, states);
 		}
 	}
+	target.endBatch();
+}
+
+const Scene::CullingStatistics& Scene::getCullingStatistics() const
+{
+	return _cullingStatistics;
+}
+
+SpatialHash& Scene::getSpatialHash()
+{
+	return _spatialHash;
+}
+
+const SpatialHash& Scene::getSpatialHash() const
+{
+	return _spatialHash;
+}
+
+TriggerSystem& Scene::getTriggers()
+{
+	return _triggers;
+}
+
+const TriggerSystem& Scene::getTriggers() const
+{
+	return _triggers;
+}
+
+std::vector<Entity*> Scene::queryAABB(float minX, float minZ, float maxX, float maxZ)
+{
+	std::vector<Entity*> result;
+	_spatialHash.query({ minX, minZ, maxX, maxZ }, SpatialHash::Colliders, [&](Component* component) {
+		result.push_back(component->getEntity());
+	});
+	return result;
+}
+
+std::vector<Entity*> Scene::queryRadius(float x, float z, float radius)
+{
+	std::vector<Entity*> result;
+	for (Component* component : _spatialHash.queryRadius({ x, z }, radius, SpatialHash::Colliders))
+	{
+		result.push_back(component->getEntity());
+	}
+	return result;
+}
+
+Entity* Scene::raycast(float x, float z, float directionX, float directionZ, float maxDistance, float* distance)
+{
+	Component* component = _spatialHash.raycast({ x, z }, { directionX, directionZ }, maxDistance, SpatialHash::Colliders, distance);
+	return component ? component->getEntity() : nullptr;
 }
 
 size_t Scene::getID() const
@@ -116,6 +301,7 @@ const ScenesManager* Scene::getScenes() const
 Entity* Scene::addEntity(const std::string& group)
 {
 	auto* entity = getEntities(group).emplace_back(std::make_unique<Entity>(this, group)).get();
+	_indexEntity(entity);
 
 	#ifdef EDITOR
 	auto* base = entity->addComponent<BaseComponent>();
@@ -131,6 +317,7 @@ Entity* Scene::addEntity(const std::string& group)
 Entity* Scene::addRawEntity(const std::string& group)
 {
 	auto* entity = getEntities(group).emplace_back(std::make_unique<Entity>(this, group)).get();
+	_indexEntity(entity);
 
 	return entity;
 }
@@ -140,6 +327,7 @@ Entity* Scene::duplicateEntity(size_t id)
 	if (auto ptr = getEntity(id); ptr != nullptr)
 	{
 		auto entity = getEntities(ptr->getGroup()).emplace_back(std::make_unique<Entity>(*ptr)).get();
+		_indexEntity(entity);
 
 		if (auto comp = entity->getComponentAs<ScriptableComponent>(); comp != nullptr)
 		{
@@ -186,6 +374,8 @@ bool Scene::removeEntity(const std::string& group, size_t id)
 		}
 		#endif //EDITOR
 
+		_unindexEntity(it->get());
+		_destroyedEntities.erase(std::remove(_destroyedEntities.begin(), _destroyedEntities.end(), it->get()), _destroyedEntities.end());
 		getEntities(group).erase(it);
 
 		return true;
@@ -196,20 +386,22 @@ bool Scene::removeEntity(const std::string& group, size_t id)
 
 bool Scene::removeEntity(size_t id)
 {
-	bool deleted = false;
-
-	deleted += removeEntity("single", id);
-	deleted += removeEntity("path", id);
-	deleted += removeEntity("foreground", id);
-	deleted += removeEntity("background", id);
-	deleted += removeEntity("entries", id);
-	deleted += removeEntity("battles", id);
+	if (auto* entity = getEntity(id))
+	{
+		return removeEntity(entity->getGroup(), id);
+	}
 
-	return deleted;
+	return false;
 }
 
 void Scene::removeAllEntities(const std::string& group)
 {
+	for (auto& entity : getEntities(group))
+	{
+		_unindexEntity(entity.get());
+		_destroyedEntities.erase(std::remove(_destroyedEntities.begin(), _destroyedEntities.end(), entity.get()), _destroyedEntities.end());
+	}
+
 	getEntities(group).clear();
 }
 
@@ -219,44 +411,79 @@ void Scene::removeAllEntities()
 	{
 		holder.second.clear();
 	}
+
+	_entitiesByID.clear();
+	_entitiesByName.clear();
+	_destroyedEntities.clear();
+
+	_player = nullptr;
+	_currentCamera = nullptr;
+	_triggers.clear();
 }
 
-Entity* Scene::getEntity(size_t id)
+void Scene::removeDestroyedEntities()
 {
-	if (auto it = _find("single", id); it != getEntities("single").end())
+	if (_destroyedEntities.empty())
 	{
-		return it->get();
+		return;
 	}
 
-	if (auto it = _find("path", id); it != getEntities("path").end())
-	{
-		return it->get();
-	}
+	PROFILE_FUNCTION();
 
-	if (auto it = _find("foreground", id); it != getEntities("foreground").end())
-	{
-		return it->get();
-	}
+	#ifdef EDITOR
+	auto& objects = detail::globalPtr<World>->getLevelEditor().getObjectsList();
+	#endif //EDITOR
 
-	if (auto it = _find("background", id); it != getEntities("background").end())
+	bool touchedGroups[GroupsCount] {};
+	for (auto* entity : _destroyedEntities)
 	{
-		return it->get();
+		touchedGroups[getGroupFromName(entity->getGroup())] = true;
+		_unindexEntity(entity);
+
+		if (entity == _player) _player = nullptr;
+		if (entity == _currentCamera) _currentCamera = nullptr;
+
+		#ifdef EDITOR
+		if (entity->getID() == objects.getSelectedID())
+		{
+			objects.unselect();
+		}
+		#endif //EDITOR
 	}
+	_destroyedEntities.clear();
 
-	if (auto it = _find("entries", id); it != getEntities("entries").end())
+	// One pass per group keeps drawing order of remaining entities
+	for (size_t group = 0; group < GroupsCount; ++group)
 	{
-		return it->get();
+		if (touchedGroups[group])
+		{
+			auto& entities = getEntities(static_cast<Group>(group));
+			entities.erase(std::remove_if(entities.begin(), entities.end(), [](const std::unique_ptr<Entity>& entity) {
+				return !entity->exists();
+			}), entities.end());
+		}
 	}
+}
 
-	if (auto it = _find("battles", id); it != getEntities("battles").end())
+Entity* Scene::getEntity(size_t id)
+{
+	if (auto it = _entitiesByID.find(id); it != _entitiesByID.end())
 	{
-		return it->get();
+		return it->second;
 	}
 
 	return nullptr;
 }
 
 Entity* Scene::getEntity(const std::string& name) {
+	auto range = _entitiesByName.equal_range(name);
+	if(range.first == range.second) {
+		return nullptr;
+	}
+	if(std::next(range.first) == range.second) {
+		return range.first->second;
+	}
+	// Duplicated names, keep returning first one in groups order
 	for(auto& group : _collectingHolder) {
 		for(auto& entity : group.second) {
 			if(entity->getName() == name) {
@@ -264,39 +491,14 @@ Entity* Scene::getEntity(const std::string& name) {
 			}
 		}
 	}
-	return nullptr;
+	return range.first->second;
 }
 
 const Entity* Scene::getEntity(size_t id) const
 {
-	if (auto it = _find("single", id); it != getEntities("single").end())
-	{
-		return it->get();
-	}
-
-	if (auto it = _find("path", id); it != getEntities("path").end())
+	if (auto it = _entitiesByID.find(id); it != _entitiesByID.end())
 	{
-		return it->get();
-	}
-
-	if (auto it = _find("foreground", id); it != getEntities("foreground").end())
-	{
-		return it->get();
-	}
-
-	if (auto it = _find("background", id); it != getEntities("background").end())
-	{
-		return it->get();
-	}
-
-	if (auto it = _find("entries", id); it != getEntities("entries").end())
-	{
-		return it->get();
-	}
-
-	if (auto it = _find("battles", id); it != getEntities("battles").end())
-	{
-		return it->get();
+		return it->second;
 	}
 
 	return nullptr;
@@ -304,9 +506,9 @@ const Entity* Scene::getEntity(size_t id) const
 
 Entity* Scene::getEntity(const std::string& group, size_t id)
 {
-	if (auto it = _find(group, id); it != getEntities(group).end())
+	if (auto* entity = getEntity(id); entity && getGroupFromName(entity->getGroup()) == getGroupFromName(group))
 	{
-		return it->get();
+		return entity;
 	}
 
 	return nullptr;
@@ -314,9 +516,9 @@ Entity* Scene::getEntity(const std::string& group, size_t id)
 
 const Entity* Scene::getEntity(const std::string& group, size_t id) const
 {
-	if (auto it = _find(group, id); it != getEntities(group).end())
+	if (auto* entity = getEntity(id); entity && getGroupFromName(entity->getGroup()) == getGroupFromName(group))
 	{
-		return it->get();
+		return entity;
 	}
 
 	return nullptr;
@@ -324,60 +526,48 @@ const Entity* Scene::getEntity(const std::string& group, size_t id) const
 
 bool Scene::hasEntity(size_t id)
 {
-	if (_find("single", id) != getEntities("single").end())
-	{
-		return true;
-	}
-
-	if (_find("path", id) != getEntities("path").end())
-	{
-		return true;
-	}
-
-	if (_find("foreground", id) != getEntities("foreground").end())
-	{
-		return true;
-	}
-
-	if (_find("background", id) != getEntities("background").end())
-	{
-		return true;
-	}
-
-	if (_find("entries", id) != getEntities("entries").end())
-	{
-		return true;
-	}
-
-	if (_find("battles", id) != getEntities("battles").end())
-	{
-		return true;
-	}
-
-	return false;
+	return _entitiesByID.count(id) != 0;
 }
 
 bool Scene::hasEntity(const std::string& group, size_t id)
 {
-	return _find(group, id) != getEntities(group).end();
+	return getEntity(group, id) != nullptr;
 }
 
 Scene::EntitiesHolder_t& Scene::getEntities(const std::string& group) 
 { 
-	for(auto& gr : getAllEntities()) { 
-		if(gr.first == group) return gr.second; 
-	} 
-	return getAllEntities()[0].second; 
+	return getEntities(getGroupFromName(group));
 } 
 
 const Scene::EntitiesHolder_t& Scene::getEntities(const std::string& group) const 
 { 
-	for(auto& gr : getAllEntities()) { 
-		if(gr.first == group) return gr.second; 
-	} 
-	return getAllEntities()[0].second; 
+	return getEntities(getGroupFromName(group));
 } 
 
+Scene::EntitiesHolder_t& Scene::getEntities(Group group)
+{
+	return _collectingHolder[group].second;
+}
+
+const Scene::EntitiesHolder_t& Scene::getEntities(Group group) const
+{
+	return _collectingHolder[group].second;
+}
+
+Scene::Group Scene::getGroupFromName(const std::string& name)
+{
+	switch (fnv1a_64(name.begin(), name.end()))
+	{
+		case fnv1a_64("background"): return Background;
+		case fnv1a_64("single"):     return Single;
+		case fnv1a_64("path"):       return Path;
+		case fnv1a_64("entries"):    return Entries;
+		case fnv1a_64("battles"):    return Battles;
+		case fnv1a_64("foreground"): return Foreground;
+		default:                     return Background;
+	}
+}
+
 Scene::CollectingHolder_t& Scene::getAllEntities()
 {
 	return _collectingHolder;
@@ -430,7 +620,7 @@ Entity* Scene::getCamera()
 {
 	if (!_currentCamera) {
 		// @todo ! ja pierdole te kontenery
-		for (auto& entity : getEntities("single")) {
+		for (auto& entity : getEntities(Single)) {
 			// @todo . Zrobić changeCamera i pozwolić na wiele kamer.
 			if (entity->hasComponent<CameraComponent>()) {
 				_currentCamera = entity.get();
@@ -527,6 +717,59 @@ typename Scene::EntitiesHolder_t::const_iterator Scene::_find(const std::string&
 	});
 }
 
+void Scene::_indexEntity(Entity* entity)
+{
+	_entitiesByID[entity->getID()] = entity;
+	_entitiesByName.emplace(entity->getName(), entity);
+}
+
+void Scene::_unindexEntity(Entity* entity)
+{
+	if (auto it = _entitiesByID.find(entity->getID()); it != _entitiesByID.end() && it->second == entity)
+	{
+		_entitiesByID.erase(it);
+	}
+
+	auto range = _entitiesByName.equal_range(entity->getName());
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == entity)
+		{
+			_entitiesByName.erase(it);
+			break;
+		}
+	}
+}
+
+void Scene::_queueDestruction(Entity* entity)
+{
+	_destroyedEntities.push_back(entity);
+}
+
+void Scene::_onEntityIDChanged(Entity* entity, size_t oldID)
+{
+	// Entity may be not added yet, for example while being copied
+	if (auto it = _entitiesByID.find(oldID); it != _entitiesByID.end() && it->second == entity)
+	{
+		_entitiesByID.erase(it);
+		_entitiesByID[entity->getID()] = entity;
+	}
+}
+
+void Scene::_onEntityRenamed(Entity* entity, const std::string& oldName)
+{
+	auto range = _entitiesByName.equal_range(oldName);
+	for (auto it = range.first; it != range.second; ++it)
+	{
+		if (it->second == entity)
+		{
+			_entitiesByName.erase(it);
+			_entitiesByName.emplace(entity->getName(), entity);
+			break;
+		}
+	}
+}
+
 void Scene::initScript(Script& script) {
 	auto object = script.newClass<Scene>("Scene", "World");
 
@@ -544,6 +787,33 @@ void Scene::initScript(Script& script) {
 			return s->duplicateEntity(e->getID());
 		}
 	);
+	// Spatial queries return tables of entities with colliders
+	object.set("queryAABB", [&](Scene* s, float minX, float minZ, float maxX, float maxZ) {
+		sol::table table = script.get().create_table();
+		for (Entity* entity : s->queryAABB(minX, minZ, maxX, maxZ)) {
+			table.add(entity);
+		}
+		return table;
+	});
+	object.set("queryRadius", [&](Scene* s, float x, float z, float radius) {
+		sol::table table = script.get().create_table();
+		for (Entity* entity : s->queryRadius(x, z, radius)) {
+			table.add(entity);
+		}
+		return table;
+	});
+	object.set("raycast", [&](Scene* s, float x, float z, float directionX, float directionZ, float maxDistance) {
+		float distance = 0.f;
+		Entity* entity = s->raycast(x, z, directionX, directionZ, maxDistance, &distance);
+		return std::make_tuple(entity, distance);
+	});
+	// Entities besides player which set off triggers
+	object.set("addTriggerSubject", [&](Scene* s, Entity* e) {
+		s->getTriggers().addSubject(e);
+	});
+	object.set("removeTriggerSubject", [&](Scene* s, Entity* e) {
+		s->getTriggers().removeSubject(e);
+	});
 	object.setOverload("removeEntity", 
 		[&](Scene* s, const std::string& name) {
 			return s->removeEntity(s->getEntity(name)->getID());
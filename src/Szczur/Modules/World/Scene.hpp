@@ -12,6 +12,8 @@
 #include <Szczur/Utility/SFML3D/RenderStates.hpp>
 
 #include "Entity.hpp"
+#include "SpatialHash.hpp"
+#include "TriggerSystem.hpp"
 
 namespace rat
 {
@@ -36,6 +38,25 @@ public:
 	//using CollectingHolder_t          = boost::container::flat_map<std::string, EntitiesHolder_t>; @todo
 	using SpriteDisplayDataHolder_t   = std::vector<SpriteDisplayData>;
 
+	/// Counters of entities checked against camera view in last `draw`
+	struct CullingStatistics
+	{
+		size_t tested {0};
+		size_t culled {0};
+	};
+
+	/// Groups in drawing order, value is index in collecting holder
+	enum Group : size_t
+	{
+		Background,
+		Single,
+		Path,
+		Entries,
+		Battles,
+		Foreground,
+		GroupsCount
+	};
+
 	///
 	Scene(ScenesManager* _parent);
 
@@ -60,6 +81,9 @@ public:
 	///
 	virtual void draw(sf3d::RenderTarget& target, sf3d::RenderStates states = sf3d::RenderStates::Default) const override;
 
+	///
+	const CullingStatistics& getCullingStatistics() const;
+
 	///
 	size_t getID() const;
 
@@ -99,6 +123,9 @@ public:
 	///
 	void removeAllEntities();
 
+	/// Removes entities destroyed since last call, called at the end of update
+	void removeDestroyedEntities();
+
 	///
 	Entity* getEntity(size_t id);
 
@@ -126,6 +153,15 @@ public:
 	///
 	const EntitiesHolder_t& getEntities(const std::string& group) const;
 
+	///
+	EntitiesHolder_t& getEntities(Group group);
+
+	///
+	const EntitiesHolder_t& getEntities(Group group) const;
+
+	/// Group of given name found by hash, unknown names give first group
+	static Group getGroupFromName(const std::string& name);
+
 	///
 	CollectingHolder_t& getAllEntities();
 
@@ -150,6 +186,27 @@ public:
 
 	/// Get any camera if no current present
 	Entity* getCamera();
+
+	/// Bounds of colliders, triggers and interactables on XZ plane
+	SpatialHash& getSpatialHash();
+
+	///
+	const SpatialHash& getSpatialHash() const;
+
+	/// Overlaps of trigger volumes with player and other subjects
+	TriggerSystem& getTriggers();
+
+	///
+	const TriggerSystem& getTriggers() const;
+
+	/// Entities which colliders overlap rectangle on XZ plane
+	std::vector<Entity*> queryAABB(float minX, float minZ, float maxX, float maxZ);
+
+	/// Entities which colliders overlap circle on XZ plane
+	std::vector<Entity*> queryRadius(float x, float z, float radius);
+
+	/// First entity which collider is hit by ray on XZ plane, nullptr if none is nearer than max distance
+	Entity* raycast(float x, float z, float directionX, float directionZ, float maxDistance, float* distance = nullptr);
 	
 	///
 	void loadFromConfig(Json& config, bool withNewID = false);
@@ -178,17 +235,59 @@ public:
 
 private:
 
+	friend class Entity;
+
 	///
 	typename EntitiesHolder_t::iterator _find(const std::string& group, size_t id);
 
 	///
 	typename EntitiesHolder_t::const_iterator _find(const std::string& group, size_t id) const;
 
+	/// Updates all components of given type belonging to this scene, on job system workers if type is thread-safe
+	template <typename T>
+	void _updatePass(float deltaTime);
+
+	/// Moves colliders, triggers and interactables changed since last frame in spatial hash
+	void _updateSpatialHash();
+
+	/// Calls interactables near player when interaction key is released
+	void _updateInteractions();
+
+	/// Adds entity to ID and name indices
+	void _indexEntity(Entity* entity);
+
+	///
+	void _unindexEntity(Entity* entity);
+
+	/// Called by entity stored in this scene when it is destroyed
+	void _queueDestruction(Entity* entity);
+
+	/// Called by entity stored in this scene when its ID is changed
+	void _onEntityIDChanged(Entity* entity, size_t oldID);
+
+	/// Called by entity stored in this scene when its name is changed
+	void _onEntityRenamed(Entity* entity, const std::string& oldName);
+
 	size_t _id;
 	std::string _name;
 	ScenesManager* _parent;
+	// Declared before entities, so their colliders can leave it when destroyed
+	SpatialHash _spatialHash;
+	TriggerSystem _triggers;
+
 	CollectingHolder_t _collectingHolder;
 	SpriteDisplayDataHolder_t _spriteDisplayDataHolder;
+
+	std::unordered_map<size_t, Entity*> _entitiesByID;
+	std::unordered_multimap<std::string, Entity*> _entitiesByName;
+
+	/// Entities destroyed during update, removed at its end
+	std::vector<Entity*> _destroyedEntities;
+
+	/// Components of current parallel pass, kept to reuse memory
+	std::vector<Component*> _parallelComponents;
+
+	mutable CullingStatistics _cullingStatistics;
 	
 	size_t _playerID {0u};
 	Entity* _player {nullptr};
@@ -1,12 +1,21 @@
 #include "ScenesManager.hpp"
 
 #include <algorithm>
+#include <cstring>
 #include <experimental/filesystem>
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <stdexcept>
 
 #include "Components/CameraComponent.hpp"
 #include "Components/BaseComponent.hpp"
 #include "Components/ScriptableComponent.hpp"
 #include "Components/PointLightComponent.hpp"
+#include "Components/SpriteComponent.hpp"
+#include "Components/AnimatedSpriteComponent.hpp"
+#include "Components/TriggerComponent.hpp"
 
 #include "Szczur/Modules/FileSystem/FileDialog.hpp"
 #include "Szczur/Modules/World/World.hpp"
@@ -17,6 +26,12 @@
 
 #include "Szczur/Utility/SFML3D/LightPoint.hpp"
 
+#include "Szczur/Utility/FileWatcher.hpp"
+#include "Szczur/Utility/Profiler.hpp"
+
+#include "Data/SpriteDisplayData.hpp"
+#include "Data/TextureAtlas.hpp"
+
 namespace rat
 {
 
@@ -59,6 +74,7 @@ bool ScenesManager::removeScene(size_t id)
 	if (auto it = _find(id); it != _holder.end())
 	{
 		_holder.erase(it);
+		_unloadedScenes.erase(id);
 
 		if (_currentSceneID == id)
 		{
@@ -77,6 +93,11 @@ bool ScenesManager::removeScene(size_t id)
 void ScenesManager::removeAllScenes()
 {
 	_holder.clear();
+	_unloadedScenes.clear();
+	_worldFile.close();
+
+	_preloadQueue.clear();
+	_streamedSceneID = 0u;
 
 	_currentSceneID = 0u;
 
@@ -124,6 +145,8 @@ bool ScenesManager::setCurrentScene(size_t id)
 {
 	if (hasScene(id))
 	{
+		loadScene(id);
+
 		#ifdef EDITOR
 		detail::globalPtr<World>->getLevelEditor().getObjectsList().unselect();
 		#endif //EDITOR
@@ -174,36 +197,40 @@ void ScenesManager::loadFromConfig(Json& config) {
 		auto* scene = addScene();
 		scene->removeAllEntities();
 		scene->loadFromConfig(current);
+		_setupScene(scene);
+	}
+}
 
-		bool foundPlayer = false;
-		bool foundCamera = false;
-		
-		for (auto& entity : scene->getEntities("single")) {
-			if (entity->getName() == "Player") {
-				foundPlayer = true;
-				scene->setPlayer(entity.get());
-			}
-			else if (entity->getName() == "Camera") {
-				foundCamera = true;
-			}
-		}
-
-		if (!foundPlayer) {
-			Entity* player = scene->addEntity("single");
-			player->setName("Player");
-			scene->setPlayer(player);
+void ScenesManager::_setupScene(Scene* scene) {
+	bool foundPlayer = false;
+	bool foundCamera = false;
+	
+	for (auto& entity : scene->getEntities(Scene::Single)) {
+		if (entity->getName() == "Player") {
+			foundPlayer = true;
+			scene->setPlayer(entity.get());
 		}
-		if (!foundCamera) {			
-			Entity* camera = scene->addEntity("single");
-			camera->addComponent<CameraComponent>();
-			camera->setName("Camera");
-			camera->setPosition({ 0.f, 1160.f, 3085.f });
-			camera->setRotation({ 15.f, 0.f, 0.f });
+		else if (entity->getName() == "Camera") {
+			foundCamera = true;
 		}
 	}
+
+	if (!foundPlayer) {
+		Entity* player = scene->addEntity("single");
+		player->setName("Player");
+		scene->setPlayer(player);
+	}
+	if (!foundCamera) {			
+		Entity* camera = scene->addEntity("single");
+		camera->addComponent<CameraComponent>();
+		camera->setName("Camera");
+		camera->setPosition({ 0.f, 1160.f, 3085.f });
+		camera->setRotation({ 15.f, 0.f, 0.f });
+	}
 }
 
 void ScenesManager::saveToConfig(Json& config) {
+	_loadAllScenes();
 
 	config["version"] = std::string("1.6.7");
 	config["currentSceneID"] = getCurrentSceneID();
@@ -224,6 +251,11 @@ void ScenesManager::saveEntityToConfig(Entity* entity, Json& config) {
 	
 	for(auto& scene : scenes) { 
 		if(scene["id"].get<int>() == sceneID) { 
+			// Scene not loaded before run is only a stub in run config
+			if (auto it = _unloadedBeforeRun.find(sceneID); &config == &_configBeforeRun && it != _unloadedBeforeRun.end()) {
+				scene = Json::from_msgpack(it->second.payload);
+				_unloadedBeforeRun.erase(it);
+			}
 			auto& group = scene["groups"][entity->getGroup()]; 
 			if(!group.is_null()) { 
 				for(auto& ent : group) { 
@@ -245,6 +277,19 @@ void ScenesManager::saveEntityToConfig(Entity* entity, Json& config) {
 
 void ScenesManager::loadFromFile(const std::string& filepath)
 {
+	namespace fs = std::experimental::filesystem;
+
+	// Atlas is loaded first, so sprites do not request separate textures
+	if (auto atlasPath = TextureAtlas::getPathForWorld(filepath); fs::exists(atlasPath)) {
+		_textureDataHolder.loadAtlas(atlasPath);
+	}
+
+	// Binary world is used if it was written from same world file content
+	if (auto binaryPath = getBinaryPath(filepath); fs::exists(binaryPath) && readBinarySourceHash(binaryPath) == hashSourceFile(filepath)) {
+		loadFromBinaryFile(binaryPath);
+		return;
+	}
+
 	std::ifstream file{ filepath };
 	Json config;
 
@@ -253,13 +298,444 @@ void ScenesManager::loadFromFile(const std::string& filepath)
 	loadFromConfig(config);
 }
 
+void ScenesManager::buildAtlas(const std::string& filepath)
+{
+	Json config;
+	saveToConfig(config);
+
+	TextureAtlas atlas;
+	atlas.build(TextureAtlas::collectTextures(config));
+	atlas.saveToFile(TextureAtlas::getPathForWorld(filepath));
+}
+
 void ScenesManager::saveToFile(const std::string& filepath)
 {
-	std::ofstream file{ filepath };
+	{
+		std::ofstream file{ filepath };
+		Json config;
+
+		saveToConfig(config);
+		file << std::setw(4) << config << std::endl;
+	}
+
+	saveToBinaryFile(getBinaryPath(filepath), filepath);
+}
+
+namespace
+{
+	constexpr char BinaryWorldMagic[4] = { 'S', 'Z', 'W', 'B' };
+	constexpr std::uint32_t BinaryWorldVersion = 2;
+
+	template <typename T>
+	void writeBinary(std::ostream& stream, const T& value)
+	{
+		stream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+	}
+
+	template <typename T>
+	T readBinary(const MappedFile& file, size_t& offset)
+	{
+		if (offset + sizeof(T) > file.getSize()) {
+			throw std::runtime_error("Binary world file is truncated");
+		}
+
+		T value;
+		std::memcpy(&value, file.getData() + offset, sizeof(T));
+		offset += sizeof(T);
+		return value;
+	}
+
+	/// Reads header, throws for other files and versions
+	void readBinaryHeader(const MappedFile& file, size_t& offset)
+	{
+		char magic[sizeof(BinaryWorldMagic)];
+		for (auto& character : magic) {
+			character = readBinary<char>(file, offset);
+		}
+		if (std::memcmp(magic, BinaryWorldMagic, sizeof(magic)) != 0 || readBinary<std::uint32_t>(file, offset) != BinaryWorldVersion) {
+			throw std::runtime_error("Unsupported binary world file");
+		}
+	}
+}
+
+Hash64_t ScenesManager::hashSourceFile(const std::string& filepath)
+{
+	const MappedFile file(filepath);
+
+	// Size is mixed in, so truncated file differs even on hash collision
+	return fnv1a_64(file.getData(), file.getData() + file.getSize()) ^ (static_cast<Hash64_t>(file.getSize()) * 0x9E3779B97F4A7C15ull);
+}
+
+Hash64_t ScenesManager::readBinarySourceHash(const std::string& filepath)
+{
+	try {
+		const MappedFile file(filepath);
+
+		size_t offset = 0;
+		readBinaryHeader(file, offset);
+		return readBinary<std::uint64_t>(file, offset);
+	}
+	catch (const std::exception&) {
+		// Unreadable or outdated binary is never fresh
+		return 0;
+	}
+}
+
+void ScenesManager::saveToBinaryFile(const std::string& filepath, const std::string& sourcePath)
+{
+	_loadAllScenes();
+
+	// Scenes are encoded first, so table of contents can point at them
+	std::vector<std::vector<std::uint8_t>> payloads;
+	size_t maxEntityID = 0;
+	size_t tocSize = 0;
+	for (auto& scene : _holder) {
+		Json config;
+		scene->saveToConfig(config);
+		payloads.push_back(Json::to_msgpack(config));
+
+		scene->forEach([&](const std::string&, Entity& entity) {
+			maxEntityID = std::max(maxEntityID, entity.getID());
+		});
+
+		tocSize += sizeof(std::uint64_t) * 3 + sizeof(std::uint32_t) + scene->getName().size();
+	}
+
+	std::ofstream file{ filepath, std::ios::binary };
+	if (!file) {
+		throw std::runtime_error("Cannot write binary world to " + filepath);
+	}
+
+	// Header
+	file.write(BinaryWorldMagic, sizeof(BinaryWorldMagic));
+	writeBinary<std::uint32_t>(file, BinaryWorldVersion);
+	writeBinary<std::uint64_t>(file, sourcePath.empty() ? 0 : hashSourceFile(sourcePath));
+	writeBinary<std::uint64_t>(file, getCurrentSceneID());
+	writeBinary<std::uint64_t>(file, maxEntityID);
+	writeBinary<std::uint32_t>(file, static_cast<std::uint32_t>(_holder.size()));
+
+	// Table of contents
+	std::uint64_t offset = sizeof(BinaryWorldMagic) + sizeof(std::uint32_t) * 2 + sizeof(std::uint64_t) * 3 + tocSize;
+	for (size_t i = 0; i < _holder.size(); ++i) {
+		const auto& name = _holder[i]->getName();
+		writeBinary<std::uint64_t>(file, _holder[i]->getID());
+		writeBinary<std::uint64_t>(file, offset);
+		writeBinary<std::uint64_t>(file, payloads[i].size());
+		writeBinary<std::uint32_t>(file, static_cast<std::uint32_t>(name.size()));
+		file.write(name.data(), name.size());
+
+		offset += payloads[i].size();
+	}
+
+	// Scenes
+	for (auto& payload : payloads) {
+		file.write(reinterpret_cast<const char*>(payload.data()), payload.size());
+	}
+}
+
+void ScenesManager::loadFromBinaryFile(const std::string& filepath)
+{
+	removeAllScenes();
+
+	_worldFile.open(filepath);
+
+	size_t offset = 0;
+	try {
+		readBinaryHeader(_worldFile, offset);
+	}
+	catch (const std::exception&) {
+		_worldFile.close();
+		throw std::runtime_error("Unsupported binary world file " + filepath);
+	}
+
+	// Source hash is only checked before loading
+	readBinary<std::uint64_t>(_worldFile, offset);
+
+	const size_t currentSceneID = readBinary<std::uint64_t>(_worldFile, offset);
+
+	// Entities of not loaded scenes keep their IDs reserved
+	trySettingInitialUniqueID<Entity>(readBinary<std::uint64_t>(_worldFile, offset));
+
+	// Scenes are only named in table of contents, their entities are loaded on demand
+	const auto count = readBinary<std::uint32_t>(_worldFile, offset);
+	for (std::uint32_t i = 0; i < count; ++i) {
+		_SceneEntry entry;
+		const size_t id = readBinary<std::uint64_t>(_worldFile, offset);
+		entry.offset = readBinary<std::uint64_t>(_worldFile, offset);
+		entry.size = readBinary<std::uint64_t>(_worldFile, offset);
+		const auto nameSize = readBinary<std::uint32_t>(_worldFile, offset);
+		if (offset + nameSize > _worldFile.getSize() || entry.offset + entry.size > _worldFile.getSize()) {
+			removeAllScenes();
+			throw std::runtime_error("Binary world file is truncated");
+		}
+		std::string name(reinterpret_cast<const char*>(_worldFile.getData() + offset), nameSize);
+		offset += nameSize;
+
+		Json stub = { { "id", id }, { "name", name }, { "groups", Json::object() } };
+		_holder.emplace_back(std::make_unique<Scene>(this))->loadFromConfig(stub);
+		_unloadedScenes[id] = entry;
+	}
+
+	_currentSceneID = hasScene(currentSceneID) || _holder.empty() ? currentSceneID : _holder.front()->getID();
+	loadScene(_currentSceneID);
+}
+
+void ScenesManager::loadScene(size_t id)
+{
+	auto it = _unloadedScenes.find(id);
+	if (it == _unloadedScenes.end()) {
+		return;
+	}
+
+	PROFILE_FUNCTION();
+
 	Json config;
+	if (it->second.payload.empty()) {
+		const auto* begin = _worldFile.getData() + it->second.offset;
+		config = Json::from_msgpack(std::vector<std::uint8_t>(begin, begin + it->second.size));
+	}
+	else {
+		config = Json::from_msgpack(it->second.payload);
+	}
+	_unloadedScenes.erase(it);
 
-	saveToConfig(config);
-	file << std::setw(4) << config << std::endl;
+	auto* scene = getScene(id);
+	scene->removeAllEntities();
+	scene->loadFromConfig(config);
+	_setupScene(scene);
+
+	// Scenes loaded during game start like ones loaded before it
+	if (_gameIsRunning) {
+		_startScene(scene);
+	}
+
+	// Mapping is not needed anymore
+	const bool fileUsed = std::any_of(_unloadedScenes.begin(), _unloadedScenes.end(), [](const auto& entry) {
+		return entry.second.payload.empty();
+	});
+	if (!fileUsed) {
+		_worldFile.close();
+	}
+}
+
+bool ScenesManager::isSceneLoaded(size_t id) const
+{
+	return hasScene(id) && _unloadedScenes.count(id) == 0;
+}
+
+bool ScenesManager::unloadScene(size_t id)
+{
+	auto* scene = getScene(id);
+	if (!scene || !isSceneLoaded(id) || id == _currentSceneID) {
+		return false;
+	}
+
+	// State of running scripts cannot be saved, so their scenes stay loaded
+	if (_gameIsRunning) {
+		bool hasScripts = false;
+		scene->forEach([&](const std::string&, Entity& entity) {
+			hasScripts = hasScripts || entity.hasComponent<ScriptableComponent>();
+		});
+		if (hasScripts) {
+			return false;
+		}
+	}
+
+	PROFILE_FUNCTION();
+
+	// Scene is kept as it is now, not as in world file, so its changes are not lost
+	Json config;
+	scene->saveToConfig(config);
+
+	_SceneEntry entry;
+	entry.offset = 0;
+	entry.payload = Json::to_msgpack(config);
+	entry.size = entry.payload.size();
+	_unloadedScenes[id] = std::move(entry);
+
+	// Textures without references are released by texture holder later
+	scene->removeAllEntities();
+
+	LOG_INFO("Scene ", scene->getName(), " unloaded");
+	return true;
+}
+
+void ScenesManager::preloadScene(size_t id)
+{
+	if (!hasScene(id) || isSceneLoaded(id)) {
+		return;
+	}
+
+	// Entities are created in next `updateStreaming`, outside of component update passes
+	if (std::find(_preloadQueue.begin(), _preloadQueue.end(), id) == _preloadQueue.end()) {
+		_preloadQueue.push_front(id);
+	}
+}
+
+std::vector<size_t> ScenesManager::getAdjacentScenes(size_t id) const
+{
+	std::vector<size_t> result;
+
+	// Entities of scene not loaded yet are unknown
+	auto* scene = getScene(id);
+	if (!scene || !isSceneLoaded(id)) {
+		return result;
+	}
+
+	scene->forEach([&](const std::string&, Entity& entity) {
+		if (auto* trigger = entity.getComponentAs<TriggerComponent>(); trigger && trigger->getType() == TriggerComponent::ChangeScene) {
+			if (trigger->sceneId != id && hasScene(trigger->sceneId) && std::find(result.begin(), result.end(), trigger->sceneId) == result.end()) {
+				result.push_back(trigger->sceneId);
+			}
+		}
+	});
+
+	return result;
+}
+
+std::unordered_map<size_t, size_t> ScenesManager::getSceneDistances(size_t id) const
+{
+	std::unordered_map<size_t, size_t> distances;
+	if (!hasScene(id)) {
+		return distances;
+	}
+
+	// Breadth first search over ChangeScene triggers
+	std::deque<size_t> queue { id };
+	distances[id] = 0;
+	while (!queue.empty()) {
+		const size_t current = queue.front();
+		queue.pop_front();
+
+		for (size_t next : getAdjacentScenes(current)) {
+			if (distances.emplace(next, distances[current] + 1).second) {
+				queue.push_back(next);
+			}
+		}
+	}
+
+	return distances;
+}
+
+size_t ScenesManager::getSceneMemoryUsage(size_t id) const
+{
+	auto* scene = getScene(id);
+	if (!scene || !isSceneLoaded(id)) {
+		return 0;
+	}
+
+	// Textures shared by many entities are counted once
+	std::vector<const SpriteDisplayData*> textures;
+	scene->forEach([&](const std::string&, Entity& entity) {
+		if (auto* sprite = entity.getComponentAs<SpriteComponent>(); sprite && sprite->getSpriteDisplayData()) {
+			textures.push_back(sprite->getSpriteDisplayData());
+		}
+		if (auto* sprite = entity.getComponentAs<AnimatedSpriteComponent>(); sprite && sprite->getSpriteDisplayData()) {
+			textures.push_back(sprite->getSpriteDisplayData());
+		}
+	});
+	std::sort(textures.begin(), textures.end());
+	textures.erase(std::unique(textures.begin(), textures.end()), textures.end());
+
+	size_t usage = 0;
+	for (auto* texture : textures) {
+		usage += texture->getMemorySize();
+	}
+	return usage;
+}
+
+void ScenesManager::updateStreaming()
+{
+	PROFILE_FUNCTION();
+
+	// Neighbours of new current scene are loaded before player can reach them
+	if (_streamedSceneID != _currentSceneID) {
+		_streamedSceneID = _currentSceneID;
+		for (size_t id : getAdjacentScenes(_currentSceneID)) {
+			if (!isSceneLoaded(id) && std::find(_preloadQueue.begin(), _preloadQueue.end(), id) == _preloadQueue.end()) {
+				_preloadQueue.push_back(id);
+			}
+		}
+		_streamingBudgetChecked = false;
+	}
+
+	// One scene per frame, so creating entities does not stall
+	if (!_preloadQueue.empty()) {
+		const size_t id = _preloadQueue.front();
+		_preloadQueue.pop_front();
+		loadScene(id);
+		return;
+	}
+
+	// Budget is checked once per scene change, memory of unloaded textures is freed with delay
+	if (_streamingBudgetChecked || !isGameRunning()) {
+		return;
+	}
+	_streamingBudgetChecked = true;
+
+	size_t usage = getTextureDataHolder().getMemoryUsage();
+	if (usage <= _streamingBudget) {
+		return;
+	}
+
+	// Unreachable scenes go first, then the most distant ones
+	const auto distances = getSceneDistances(_currentSceneID);
+	std::vector<std::pair<size_t, size_t>> candidates;
+	for (auto& scene : _holder) {
+		const size_t id = scene->getID();
+		if (!isSceneLoaded(id) || id == _currentSceneID) {
+			continue;
+		}
+
+		auto it = distances.find(id);
+		const size_t distance = it != distances.end() ? it->second : std::numeric_limits<size_t>::max();
+		if (distance > _streamingDistance) {
+			candidates.emplace_back(distance, id);
+		}
+	}
+	std::sort(candidates.begin(), candidates.end(), std::greater<>());
+
+	for (auto& [distance, id] : candidates) {
+		if (usage <= _streamingBudget) {
+			break;
+		}
+		const size_t sceneUsage = getSceneMemoryUsage(id);
+		if (unloadScene(id)) {
+			usage -= std::min(usage, sceneUsage);
+		}
+	}
+}
+
+void ScenesManager::setStreamingDistance(size_t hops)
+{
+	_streamingDistance = hops;
+}
+
+size_t ScenesManager::getStreamingDistance() const
+{
+	return _streamingDistance;
+}
+
+void ScenesManager::setStreamingBudget(size_t bytes)
+{
+	_streamingBudget = bytes;
+}
+
+size_t ScenesManager::getStreamingBudget() const
+{
+	return _streamingBudget;
+}
+
+std::string ScenesManager::getBinaryPath(const std::string& worldPath)
+{
+	return worldPath.substr(0, worldPath.find_last_of('.')) + ".wbin";
+}
+
+void ScenesManager::_loadAllScenes()
+{
+	while (!_unloadedScenes.empty()) {
+		loadScene(_unloadedScenes.begin()->first);
+	}
 }
 
 ScenesManager::ArmatureDisplayDataHolder_t& ScenesManager::getArmatureDisplayDataHolder()
@@ -328,27 +804,35 @@ bool ScenesManager::isGameRunning() {
 	return _gameIsRunning;
 }
 
+void ScenesManager::setCullingEnabled(bool enabled)
+{
+	_cullingEnabled = enabled;
+}
+
+bool ScenesManager::isCullingEnabled() const
+{
+	return _cullingEnabled;
+}
+
 void ScenesManager::runGame() {
 	if(!_gameIsRunning) {
 		_gameIsRunning = true;
-		saveToConfig(_configBeforeRun);
+		_saveRunConfig();
 
 		#ifdef EDITOR
 		LevelEditor& levelEditor = detail::globalPtr<World>->getLevelEditor();
 		#endif
 
 		for (auto& scene : _holder) {
-			scene->forEach([&](const std::string& group, Entity& entity) {
-				if (auto comp = entity.getComponentAs<ScriptableComponent>()) comp->runScript();
-				if (auto comp = entity.getComponentAs<AudioComponent>()) comp->play();
+			_startScene(scene.get());
 
-				#ifdef EDITOR
-				if (levelEditor.reloadArmaturesAtStart()) {
-					if (auto comp = entity.getComponentAs<ArmatureComponent>())
-						comp->unloadArmature();
-				}
-				#endif
-			});
+			#ifdef EDITOR
+			if (levelEditor.reloadArmaturesAtStart()) {
+				scene->forEach([] (const std::string& group, Entity& entity) {
+					if (auto comp = entity.getComponentAs<ArmatureComponent>()) comp->unloadArmature();
+				});
+			}
+			#endif
 		}
 
 		#ifdef EDITOR
@@ -371,10 +855,21 @@ void ScenesManager::runGame() {
 			if (auto comp = entity.getComponentAs<ScriptableComponent>()) comp->sceneChanged();
 		}
 		);
+
+		#ifdef EDITOR
+		_watchScripts();
+		#endif
 	}
 	detail::globalPtr<Equipment>->startEquipment();
 }
 
+void ScenesManager::_startScene(Scene* scene) {
+	scene->forEach([] (const std::string& group, Entity& entity) {
+		if (auto comp = entity.getComponentAs<ScriptableComponent>()) comp->runScript();
+		if (auto comp = entity.getComponentAs<AudioComponent>()) comp->play();
+	});
+}
+
 void ScenesManager::stopGame() {
 	if(_gameIsRunning) {
  
@@ -385,13 +880,69 @@ void ScenesManager::stopGame() {
 
 		#ifdef EDITOR
 		detail::globalPtr<World>->getLevelEditor().getObjectsList().unselect();
+		_unwatchScripts();
 		#endif //EDITOR
 
 		_gameIsRunning = false;
-		loadFromConfig(_configBeforeRun);
+		_loadRunConfig();
 	}
 }
 
+void ScenesManager::_saveRunConfig()
+{
+	_configBeforeRun = Json::object();
+	_unloadedBeforeRun.clear();
+
+	_configBeforeRun["version"] = std::string("1.6.7");
+	_configBeforeRun["currentSceneID"] = getCurrentSceneID();
+	Json& scenes = _configBeforeRun["scenes"] = Json::array();
+
+	for (auto& scene : _holder)
+	{
+		scenes.push_back(Json::object());
+		Json& current = scenes.back();
+
+		auto it = _unloadedScenes.find(scene->getID());
+		if (it == _unloadedScenes.end()) {
+			scene->saveToConfig(current);
+			continue;
+		}
+
+		// Not decoded, only copied out of world file which may be closed during run
+		current = { { "id", scene->getID() }, { "name", scene->getName() }, { "groups", Json::object() } };
+
+		_SceneEntry entry = it->second;
+		if (entry.payload.empty()) {
+			const auto* begin = _worldFile.getData() + entry.offset;
+			entry.payload.assign(begin, begin + entry.size);
+			entry.offset = 0;
+		}
+		_unloadedBeforeRun[scene->getID()] = std::move(entry);
+	}
+}
+
+void ScenesManager::_loadRunConfig()
+{
+	removeAllScenes();
+
+	_currentSceneID = _configBeforeRun["currentSceneID"];
+
+	for (auto& current : _configBeforeRun["scenes"]) {
+		auto* scene = addScene();
+		scene->removeAllEntities();
+		scene->loadFromConfig(current);
+
+		if (auto it = _unloadedBeforeRun.find(scene->getID()); it != _unloadedBeforeRun.end()) {
+			_unloadedScenes[it->first] = std::move(it->second);
+		}
+		else {
+			_setupScene(scene);
+		}
+	}
+
+	_unloadedBeforeRun.clear();
+}
+
 Json& ScenesManager::getRunConfig() {
 	return _configBeforeRun;
 }
@@ -415,6 +966,38 @@ typename ScenesManager::ScenesHolder_t::const_iterator ScenesManager::_find(size
 }
 
 #ifdef EDITOR
+	void ScenesManager::_watchScripts() {
+		std::vector<std::string> paths;
+		for (auto& scene : _holder) {
+			scene->forEach([&](const std::string& group, Entity& entity) {
+				if (auto comp = entity.getComponentAs<ScriptableComponent>(); comp && comp->getFilePath() != "") {
+					paths.push_back(comp->getFilePath());
+				}
+			});
+		}
+		std::sort(paths.begin(), paths.end());
+		paths.erase(std::unique(paths.begin(), paths.end()), paths.end());
+
+		for (auto& path : paths) {
+			_scriptWatches.push_back(FileWatcher::get().watch(path, [this, path](const std::string&) {
+				for (auto& scene : _holder) {
+					scene->forEach([&](const std::string& group, Entity& entity) {
+						if (auto comp = entity.getComponentAs<ScriptableComponent>(); comp && comp->getFilePath() == path) {
+							comp->runScript();
+						}
+					});
+				}
+			}));
+		}
+	}
+
+	void ScenesManager::_unwatchScripts() {
+		for (auto watch : _scriptWatches) {
+			FileWatcher::get().unwatch(watch);
+		}
+		_scriptWatches.clear();
+	}
+
 	bool ScenesManager::menuSave() {
 		if(currentFilePath == "") {
 			std::string relative = getRelativePathFromExplorer("Save world", ".\\Editor\\Saves", "Worlds (*.world)|*.world", true);
@@ -1,8 +1,14 @@
 #pragma once
 
+#include <cstdint>
+#include <deque>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "Szczur/Utility/MappedFile.hpp"
+#include "Szczur/Utility/Convert/Hash.hpp"
+
 #include "Szczur/Modules/World/Data/ArmatureDisplayData.hpp"
 
 #include "Scene.hpp"
@@ -20,6 +26,7 @@ public:
 
 	using ScenesHolder_t = std::vector<std::unique_ptr<Scene>>;
 	
+	/// Display data by folder, their parsed files are shared through `ArmatureDataCache`
 	using ArmatureDisplayDataHolder_t = std::vector<std::unique_ptr<ArmatureDisplayData>>;
 
 	///
@@ -94,6 +101,60 @@ public:
 	///
 	void saveToFile(const std::string& filepath);
 
+	/// Writes scenes in binary form, each scene can be loaded separately. Hash of source world file is stored to check freshness
+	void saveToBinaryFile(const std::string& filepath, const std::string& sourcePath = "");
+
+	/// Maps binary world, only current scene is loaded, others are loaded when they become current
+	void loadFromBinaryFile(const std::string& filepath);
+
+	/// Loads entities of scene left in binary world file
+	void loadScene(size_t id);
+
+	///
+	bool isSceneLoaded(size_t id) const;
+
+	/// Stores entities of scene in memory and removes them, scene is loaded again when it becomes current. Current scene and scenes with running scripts are never unloaded
+	bool unloadScene(size_t id);
+
+	/// Queues loading of scene, its textures are then decoded in background while current scene runs
+	void preloadScene(size_t id);
+
+	/// Scenes which ChangeScene triggers of given scene lead to
+	std::vector<size_t> getAdjacentScenes(size_t id) const;
+
+	/// Number of scene changes needed to reach loaded scenes from given one, unreachable scenes are missing
+	std::unordered_map<size_t, size_t> getSceneDistances(size_t id) const;
+
+	/// Estimated video memory taken by textures of scene sprites
+	size_t getSceneMemoryUsage(size_t id) const;
+
+	/// Preloads queued scenes and scenes next to current one, unloads distant ones when over budget. Call once per frame, before scene update
+	void updateStreaming();
+
+	/// Scenes further than this number of scene changes from current one may be unloaded
+	void setStreamingDistance(size_t hops);
+
+	///
+	size_t getStreamingDistance() const;
+
+	/// Distant scenes are unloaded while textures take more video memory than this
+	void setStreamingBudget(size_t bytes);
+
+	///
+	size_t getStreamingBudget() const;
+
+	/// Path of binary world written next to given world file
+	static std::string getBinaryPath(const std::string& worldPath);
+
+	/// Hash of world file content, binary world is up to date if it stores same one
+	static Hash64_t hashSourceFile(const std::string& filepath);
+
+	/// Source hash stored in binary world, 0 if file cannot be read
+	static Hash64_t readBinarySourceHash(const std::string& filepath);
+
+	/// Packs textures used by current world into atlas stored next to world file
+	void buildAtlas(const std::string& filepath);
+
 	///
 	void loadScenesFromFile(const std::string& filepath);
 
@@ -118,6 +179,12 @@ public:
 	///
 	Json& getRunConfig();
 
+	/// Whether scenes skip entities outside of camera view volume when drawn
+	void setCullingEnabled(bool enabled);
+
+	///
+	bool isCullingEnabled() const;
+
 	///
 	TextureDataHolder& getTextureDataHolder();
 
@@ -135,19 +202,73 @@ private:
 	///
 	typename ScenesHolder_t::const_iterator _find(size_t id) const;
 
+	/// Adds player and camera if scene lacks them
+	void _setupScene(Scene* scene);
+
+	/// Runs scripts and plays audio of entities, as at start of game
+	void _startScene(Scene* scene);
+
+	///
+	void _loadAllScenes();
+
+	/// Saves loaded scenes to run config, not loaded ones keep their binary data
+	void _saveRunConfig();
+
+	/// Restores scenes saved by `_saveRunConfig`
+	void _loadRunConfig();
+
+	#ifdef EDITOR
+	/// Watches scripts of running game, changed ones are run again
+	void _watchScripts();
+
+	///
+	void _unwatchScripts();
+	#endif
+
+// Data
+
+	// Declared before scenes, so entities release their data before holders are destroyed
+	TextureDataHolder _textureDataHolder;
+	ArmatureDisplayDataHolder_t _armatureDisplayDataHolder;
+
 	ScenesHolder_t _holder;
 	size_t _currentSceneID = 0u;
 
-	ArmatureDisplayDataHolder_t _armatureDisplayDataHolder;
+// Binary world
+
+	struct _SceneEntry
+	{
+		size_t offset;
+		size_t size;
+
+		// Scenes unloaded at runtime keep own data instead of pointing into world file
+		std::vector<std::uint8_t> payload;
+	};
+
+	MappedFile _worldFile;
+	std::unordered_map<size_t, _SceneEntry> _unloadedScenes;
+
+// Streaming
+
+	std::deque<size_t> _preloadQueue;
+	size_t _streamedSceneID = 0u;
+	bool _streamingBudgetChecked = true;
+	size_t _streamingDistance = 2u;
+	size_t _streamingBudget = 384 * 1024 * 1024;
 
 // Running state
 
 	Json _configBeforeRun;
+	std::unordered_map<size_t, _SceneEntry> _unloadedBeforeRun;
 	bool _gameIsRunning = false;
 
-// Data
+// Rendering
 
-	TextureDataHolder _textureDataHolder;
+	bool _cullingEnabled = true;
+
+	#ifdef EDITOR
+	std::vector<size_t> _scriptWatches;
+	#endif
 };
 
 }
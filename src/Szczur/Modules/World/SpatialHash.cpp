@@ -0,0 +1,228 @@
+#include "SpatialHash.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include <glm/geometric.hpp>
+
+namespace rat
+{
+
+SpatialHash::SpatialHash(float cellSize)
+	: _cellSize { cellSize }
+	, _inverseCellSize { 1.f / cellSize }
+{
+
+}
+
+void SpatialHash::update(Component* component, const Rect_t& rect, size_t layer)
+{
+	auto [it, inserted] = _entries.try_emplace(component, Entry{ component, rect, _getCells(rect), layer, 0 });
+	Entry& entry = it->second;
+
+	if (inserted)
+	{
+		_addToCells(&entry);
+		return;
+	}
+
+	entry.rect = rect;
+	entry.layer = layer;
+
+	// Most moves stay inside the same cells
+	const glm::ivec4 cells = _getCells(rect);
+	if (cells != entry.cells)
+	{
+		_removeFromCells(&entry);
+		entry.cells = cells;
+		_addToCells(&entry);
+	}
+}
+
+void SpatialHash::remove(const Component* component)
+{
+	auto it = _entries.find(component);
+	if (it != _entries.end())
+	{
+		_removeFromCells(&it->second);
+		_entries.erase(it);
+	}
+}
+
+bool SpatialHash::contains(const Component* component) const
+{
+	return _entries.find(component) != _entries.end();
+}
+
+size_t SpatialHash::getSize() const
+{
+	return _entries.size();
+}
+
+void SpatialHash::clear()
+{
+	_entries.clear();
+	_cells.clear();
+}
+
+std::vector<Component*> SpatialHash::queryAABB(const Rect_t& rect, size_t layers) const
+{
+	std::vector<Component*> result;
+	query(rect, layers, [&](Component* component) {
+		result.push_back(component);
+	});
+	return result;
+}
+
+std::vector<Component*> SpatialHash::queryRadius(const glm::vec2& center, float radius, size_t layers) const
+{
+	std::vector<Component*> result;
+	query(Rect_t(center - radius, center + radius), layers, [&](Component* component) {
+		const Rect_t& rect = _entries.at(component).rect;
+
+		// Nearest point of rectangle to center
+		const glm::vec2 nearest = glm::clamp(center, glm::vec2(rect.x, rect.y), glm::vec2(rect.z, rect.w));
+		const glm::vec2 delta = nearest - center;
+		if (glm::dot(delta, delta) <= radius * radius)
+		{
+			result.push_back(component);
+		}
+	});
+	return result;
+}
+
+Component* SpatialHash::raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, size_t layers, float* distance) const
+{
+	const float length = glm::length(direction);
+	if (length == 0.f || !(maxDistance >= 0.f) || std::isinf(maxDistance))
+	{
+		return nullptr;
+	}
+	const glm::vec2 dir = direction / length;
+	const glm::vec2 inverseDir = 1.f / dir;
+
+	++_queryStamp;
+
+	Component* hit = nullptr;
+	float best = maxDistance;
+
+	// Walks cells crossed by ray in order, until next cell is further than nearest hit
+	glm::ivec2 cell = glm::ivec2(glm::clamp(glm::floor(origin * _inverseCellSize), glm::vec2(-_maxCell), glm::vec2(_maxCell)));
+	const glm::ivec2 step { dir.x > 0.f ? 1 : -1, dir.y > 0.f ? 1 : -1 };
+	const glm::vec2 deltaT = glm::abs(glm::vec2(_cellSize) * inverseDir);
+	glm::vec2 nextT;
+	for (int axis = 0; axis < 2; ++axis)
+	{
+		if (dir[axis] == 0.f)
+		{
+			nextT[axis] = std::numeric_limits<float>::infinity();
+		}
+		else
+		{
+			const float boundary = (cell[axis] + (step[axis] > 0 ? 1 : 0)) * _cellSize;
+			nextT[axis] = (boundary - origin[axis]) * inverseDir[axis];
+		}
+	}
+
+	while (true)
+	{
+		auto it = _cells.find(_getKey(cell.x, cell.y));
+		if (it != _cells.end())
+		{
+			for (Entry* entry : it->second)
+			{
+				if (entry->stamp == _queryStamp || !(entry->layer & layers))
+				{
+					continue;
+				}
+				entry->stamp = _queryStamp;
+
+				// Slab test, starting inside gives 0
+				const glm::vec2 low { entry->rect.x, entry->rect.y };
+				const glm::vec2 high { entry->rect.z, entry->rect.w };
+				float enter = 0.f;
+				float exit = best;
+				for (int axis = 0; axis < 2 && enter <= exit; ++axis)
+				{
+					if (dir[axis] == 0.f)
+					{
+						// Parallel ray hits only if it goes between sides
+						if (origin[axis] < low[axis] || origin[axis] > high[axis])
+						{
+							exit = -1.f;
+						}
+						continue;
+					}
+
+					const float t1 = (low[axis] - origin[axis]) * inverseDir[axis];
+					const float t2 = (high[axis] - origin[axis]) * inverseDir[axis];
+					enter = std::max(enter, std::min(t1, t2));
+					exit = std::min(exit, std::max(t1, t2));
+				}
+
+				if (enter <= exit)
+				{
+					best = enter;
+					hit = entry->component;
+				}
+			}
+		}
+
+		const int axis = nextT.x < nextT.y ? 0 : 1;
+		if (nextT[axis] > best)
+		{
+			break;
+		}
+		cell[axis] += step[axis];
+		nextT[axis] += deltaT[axis];
+	}
+
+	if (hit && distance)
+	{
+		*distance = best;
+	}
+	return hit;
+}
+
+void SpatialHash::_addToCells(Entry* entry)
+{
+	for (int x = entry->cells.x; x <= entry->cells.z; ++x)
+	{
+		for (int z = entry->cells.y; z <= entry->cells.w; ++z)
+		{
+			_cells[_getKey(x, z)].push_back(entry);
+		}
+	}
+}
+
+void SpatialHash::_removeFromCells(Entry* entry)
+{
+	for (int x = entry->cells.x; x <= entry->cells.z; ++x)
+	{
+		for (int z = entry->cells.y; z <= entry->cells.w; ++z)
+		{
+			auto it = _cells.find(_getKey(x, z));
+			if (it == _cells.end())
+			{
+				continue;
+			}
+
+			auto& cell = it->second;
+			auto found = std::find(cell.begin(), cell.end(), entry);
+			if (found != cell.end())
+			{
+				*found = cell.back();
+				cell.pop_back();
+			}
+
+			// Empty cells are dropped, so walking far away does not grow map
+			if (cell.empty())
+			{
+				_cells.erase(it);
+			}
+		}
+	}
+}
+
+}
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
+#include <glm/common.hpp>
+
+namespace rat
+{
+
+// FWD
+class Component;
+
+/// Uniform grid on XZ plane, finds components whose bounds are near given area. Used from main thread only
+class SpatialHash
+{
+public:
+
+	/// Rectangle on XZ plane as { minX, minZ, maxX, maxZ }
+	using Rect_t = glm::vec4;
+
+	/// Bits telling which kind of components entry belongs to, queries skip other layers
+	enum Layer : size_t
+	{
+		Colliders = 1 << 0,
+		Triggers = 1 << 1,
+		Interactables = 1 << 2,
+		AllLayers = ~size_t(0)
+	};
+
+	/// Size of cell, should be about size of typical collider
+	static constexpr float DefaultCellSize = 512.f;
+
+	///
+	SpatialHash(float cellSize = DefaultCellSize);
+
+	// Non-copyable
+	SpatialHash(const SpatialHash&) = delete;
+	SpatialHash& operator = (const SpatialHash&) = delete;
+
+	/// Adds component or moves it to new bounds, cells are changed only if bounds cross their edges
+	void update(Component* component, const Rect_t& rect, size_t layer);
+
+	///
+	void remove(const Component* component);
+
+	///
+	bool contains(const Component* component) const;
+
+	/// Number of components added
+	size_t getSize() const;
+
+	///
+	void clear();
+
+	/// Calls function for every component in given layers whose bounds overlap rectangle, each only once
+	template <typename F>
+	void query(const Rect_t& rect, size_t layers, F&& function) const
+	{
+		const glm::ivec4 cells = _getCells(rect);
+		++_queryStamp;
+
+		// Area with more cells than entries is cheaper to check entry by entry
+		const std::int64_t cellsCount = (std::int64_t(cells.z) - cells.x + 1) * (std::int64_t(cells.w) - cells.y + 1);
+		if (cellsCount > static_cast<std::int64_t>(_entries.size()))
+		{
+			for (const auto& [component, entry] : _entries)
+			{
+				if ((entry.layer & layers) && _overlaps(entry.rect, rect))
+				{
+					function(entry.component);
+				}
+			}
+			return;
+		}
+
+		for (int x = cells.x; x <= cells.z; ++x)
+		{
+			for (int z = cells.y; z <= cells.w; ++z)
+			{
+				auto it = _cells.find(_getKey(x, z));
+				if (it == _cells.end())
+				{
+					continue;
+				}
+
+				for (Entry* entry : it->second)
+				{
+					// Entries spanning many cells are visited once
+					if (entry->stamp == _queryStamp || !(entry->layer & layers))
+					{
+						continue;
+					}
+					entry->stamp = _queryStamp;
+
+					if (_overlaps(entry->rect, rect))
+					{
+						function(entry->component);
+					}
+				}
+			}
+		}
+	}
+
+	/// Components whose bounds overlap rectangle
+	std::vector<Component*> queryAABB(const Rect_t& rect, size_t layers = AllLayers) const;
+
+	/// Components whose bounds overlap circle
+	std::vector<Component*> queryRadius(const glm::vec2& center, float radius, size_t layers = AllLayers) const;
+
+	/// First component which bounds are hit by ray, nullptr if none is nearer than max distance. Distance must be finite, cells on the way are walked one by one
+	Component* raycast(const glm::vec2& origin, const glm::vec2& direction, float maxDistance, size_t layers = AllLayers, float* distance = nullptr) const;
+
+private:
+
+	struct Entry
+	{
+		Component* component;
+		Rect_t rect;
+		glm::ivec4 cells;
+		size_t layer;
+		mutable std::uint32_t stamp;
+	};
+
+	///
+	static bool _overlaps(const Rect_t& a, const Rect_t& b)
+	{
+		return a.x <= b.z && b.x <= a.z && a.y <= b.w && b.y <= a.w;
+	}
+
+	///
+	static std::int64_t _getKey(int x, int z)
+	{
+		return static_cast<std::int64_t>((static_cast<std::uint64_t>(static_cast<std::uint32_t>(x)) << 32) | static_cast<std::uint32_t>(z));
+	}
+
+	/// Cells covered by rectangle as { minX, minZ, maxX, maxZ }, clamped so huge rectangles do not overflow int
+	glm::ivec4 _getCells(const Rect_t& rect) const
+	{
+		return glm::ivec4(glm::clamp(glm::floor(rect * _inverseCellSize), Rect_t(-_maxCell), Rect_t(_maxCell)));
+	}
+
+	/// Cells further from origin are treated as border ones
+	static constexpr float _maxCell = float(1 << 30);
+
+	///
+	void _addToCells(Entry* entry);
+
+	///
+	void _removeFromCells(Entry* entry);
+
+	float _cellSize;
+	float _inverseCellSize;
+
+	// Map nodes keep addresses, so cells may point to entries
+	std::unordered_map<const Component*, Entry> _entries;
+	std::unordered_map<std::int64_t, std::vector<Entry*>> _cells;
+
+	mutable std::uint32_t _queryStamp = 0;
+
+};
+
+/// Membership of component in spatial hash of one scene, component leaves it when handle is destroyed. Copies start outside of hash
+class SpatialHashHandle
+{
+public:
+
+	///
+	SpatialHashHandle() = default;
+
+	///
+	SpatialHashHandle(const SpatialHashHandle&)
+	{
+
+	}
+
+	///
+	SpatialHashHandle& operator = (const SpatialHashHandle&)
+	{
+		return *this;
+	}
+
+	///
+	~SpatialHashHandle()
+	{
+		reset();
+	}
+
+	/// Moves component to new bounds, leaving hash of previous scene if it has changed. Unchanged bounds are not looked up again
+	void update(SpatialHash& hash, Component* component, const SpatialHash::Rect_t& rect, size_t layer)
+	{
+		if (_hash == &hash && _component == component && _rect == rect && _layer == layer)
+		{
+			return;
+		}
+
+		if (_hash != &hash)
+		{
+			reset();
+		}
+
+		_hash = &hash;
+		_component = component;
+		_rect = rect;
+		_layer = layer;
+		_hash->update(component, rect, layer);
+	}
+
+	///
+	void reset()
+	{
+		if (_hash)
+		{
+			_hash->remove(_component);
+		}
+		_hash = nullptr;
+		_component = nullptr;
+	}
+
+private:
+
+	SpatialHash* _hash = nullptr;
+	const Component* _component = nullptr;
+	SpatialHash::Rect_t _rect;
+	size_t _layer = 0;
+
+};
+
+}
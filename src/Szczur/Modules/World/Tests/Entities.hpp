@@ -0,0 +1,297 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "Szczur/Modules/World/World.hpp"
+#include "Szczur/Modules/World/Tests/WorldBenchmark.hpp"
+#include "Szczur/Utility/Time/Clock.hpp"
+#include "Szczur/Utility/Tests.hpp"
+
+struct EntitiesBenchmark : public WorldBenchmark
+{
+	static constexpr size_t entitiesCount = 10000;
+
+	std::vector<std::pair<rat::SpriteComponent*, float>> parallaxSprites;
+
+	virtual void SetUp() override
+	{
+		WorldBenchmark::SetUp();
+
+		// Components mix similar to real scenes
+		for (size_t i = 0; i < entitiesCount; ++i) {
+			auto* entity = scene->addRawEntity("single");
+			entity->addComponent<rat::BaseComponent>();
+			auto* sprite = static_cast<rat::SpriteComponent*>(entity->addComponent<rat::SpriteComponent>());
+			if (i % 4 == 0) entity->addComponent<rat::ColliderComponent>();
+			if (i % 8 == 0) entity->addComponent<rat::InteractableComponent>();
+
+			// Half of sprites follow camera, so results of update can be checked
+			if (i % 2 == 0) {
+				Json config;
+				sprite->saveToConfig(config);
+				config["parallax"] = true;
+				config["parallaxValue"] = (i % 10) * 0.1f;
+				sprite->loadFromConfig(config);
+				parallaxSprites.emplace_back(sprite, (i % 10) * 0.1f);
+			}
+		}
+	}
+
+	/// Lookup used before slots were added
+	template <typename T>
+	static T* findByScan(const rat::Entity& entity)
+	{
+		const auto id = rat::ComponentTraits::getIdentifierFromType<T>();
+		const auto& holder = entity.getComponents();
+		auto it = std::find_if(holder.begin(), holder.end(), [=](const auto& component) {
+			return component->getComponentID() == id;
+		});
+		return it != holder.end() ? static_cast<T*>(it->get()) : nullptr;
+	}
+
+	/// Update used before passes, all components of one entity after another. Interactions and triggers
+	/// are left out, passes skip them too without input and running game
+	void updateByEntity(float deltaTime)
+	{
+		for (auto& entity : scene->getEntities(rat::Scene::Single)) {
+			if (!entity->isActive()) continue;
+			if (auto* comp = entity->getComponentAs<rat::TraceComponent>()) comp->update(*scenes, deltaTime);
+			if (auto* comp = entity->getComponentAs<rat::CameraComponent>()) comp->update(*scenes, deltaTime);
+			if (auto* comp = entity->getComponentAs<rat::ArmatureComponent>()) comp->update(*scenes, deltaTime);
+			if (auto* comp = entity->getComponentAs<rat::AnimatedSpriteComponent>()) comp->update(*scenes, deltaTime);
+			if (auto* comp = entity->getComponentAs<rat::SpriteComponent>()) comp->update(*scenes, deltaTime);
+		}
+	}
+
+	/// Moves camera, so every parallax sprite gets other offset in next update
+	void moveCamera(float x)
+	{
+		auto* camera = scene->getCamera();
+		if (camera == nullptr) {
+			throw std::runtime_error("Scene has no camera");
+		}
+		camera->setPosition({ x, 0.f, 0.f });
+	}
+
+	/// Throws if any sprite was not updated for camera at given position
+	void checkParallax(float cameraX, const char* path) const
+	{
+		for (auto& [sprite, value] : parallaxSprites) {
+			if (sprite->getParallaxOffset() != value * cameraX) {
+				throw std::runtime_error(std::string("Sprite not updated by ") + path);
+			}
+		}
+	}
+};
+
+/// Same lookups as update of each entity did, scanning components and using slots
+TEST_F(EntitiesBenchmark, ComponentLookup)
+{
+	auto& entities = scene->getEntities(rat::Scene::Single);
+
+	size_t scanned = 0;
+	rat::Clock clock;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		for (auto& entity : entities) {
+			scanned += findByScan<rat::InteractableComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::TraceComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::CameraComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::TriggerComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::ArmatureComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::AnimatedSpriteComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::SpriteComponent>(*entity) != nullptr;
+			scanned += findByScan<rat::ScriptableComponent>(*entity) != nullptr;
+		}
+	}
+	const float scanTime = clock.restart().asFSeconds();
+
+	size_t slotted = 0;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		for (auto& entity : entities) {
+			slotted += entity->getComponentAs<rat::InteractableComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::TraceComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::CameraComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::TriggerComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::ArmatureComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::AnimatedSpriteComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::SpriteComponent>() != nullptr;
+			slotted += entity->getComponentAs<rat::ScriptableComponent>() != nullptr;
+		}
+	}
+	const float slotTime = clock.restart().asFSeconds();
+
+	if (scanned != slotted) {
+		throw std::runtime_error("Slot lookup found other components than scan");
+	}
+
+	LOG_INFO("Component lookup for ", entitiesCount, " entities: scan ", perFrame(scanTime), " ms, slots ", perFrame(slotTime), " ms per frame");
+}
+
+/// Per entity update against update passes over component pools, both have to give same results
+TEST_F(EntitiesBenchmark, UpdatePasses)
+{
+	rat::Clock clock;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		moveCamera(frame * 10.f);
+		updateByEntity(1.f / 60.f);
+	}
+	const float entitiesTime = clock.restart().asFSeconds();
+	checkParallax((framesCount - 1) * 10.f, "entity");
+
+	clock.restart();
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		moveCamera(frame * 20.f);
+		scene->update(1.f / 60.f);
+	}
+	const float passesTime = clock.restart().asFSeconds();
+	checkParallax((framesCount - 1) * 20.f, "passes");
+
+	LOG_INFO("Update of ", entitiesCount, " entities: by entity ", perFrame(entitiesTime), " ms, by passes ", perFrame(passesTime), " ms per frame");
+}
+
+struct CollidersBenchmark : public WorldBenchmark
+{
+	static constexpr size_t npcsCount = 500;
+
+	std::vector<rat::ColliderComponent*> colliders;
+
+	virtual void SetUp() override
+	{
+		WorldBenchmark::SetUp();
+
+		// Crowd walking along path
+		for (size_t i = 0; i < npcsCount; ++i) {
+			auto* collider = static_cast<rat::ColliderComponent*>(addOnPath(i)->addComponent<rat::ColliderComponent>());
+			collider->setBoxCollider(true);
+			collider->setDynamic(i % 2 == 0);
+			colliders.push_back(collider);
+		}
+	}
+
+	/// Throws if spatial hash finds other overlapping colliders than checking every pair
+	void checkPairs() const
+	{
+		const auto& hash = scene->getSpatialHash();
+		for (auto* collider : colliders) {
+			const auto bounds = collider->getBounds();
+
+			std::vector<rat::Component*> expected;
+			for (auto* other : colliders) {
+				const auto rect = other->getBounds();
+				if (rect.x <= bounds.z && bounds.x <= rect.z && rect.y <= bounds.w && bounds.y <= rect.w) {
+					expected.push_back(other);
+				}
+			}
+
+			auto found = hash.queryAABB(bounds, rat::SpatialHash::Colliders);
+			std::sort(expected.begin(), expected.end());
+			std::sort(found.begin(), found.end());
+			if (found != expected) {
+				throw std::runtime_error("Spatial hash found other colliders than brute force");
+			}
+		}
+	}
+};
+
+/// Every NPC moves each frame, colliders are looked up in spatial hash
+TEST_F(CollidersBenchmark, Move)
+{
+	rat::Clock clock;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		scene->update(1.f / 60.f);
+		for (auto* collider : colliders) {
+			collider->move(frame % 2 ? 2.f : -2.f, 0.f, 1.f);
+		}
+	}
+	const float moveTime = clock.getElapsedTime().asFSeconds();
+
+	checkPairs();
+
+	LOG_INFO("Move of ", npcsCount, " colliders: ", perFrame(moveTime), " ms per frame, ", scene->getSpatialHash().getSize(), " in spatial hash");
+}
+
+struct TriggersBenchmark : public WorldBenchmark
+{
+	static constexpr size_t triggersCount = 500;
+
+	rat::Entity* player;
+	std::vector<rat::TriggerComponent*> triggers;
+
+	virtual void SetUp() override
+	{
+		WorldBenchmark::SetUp();
+
+		for (size_t i = 0; i < triggersCount; ++i) {
+			auto* trigger = static_cast<rat::TriggerComponent*>(addOnPath(i)->addComponent<rat::TriggerComponent>());
+			trigger->setType(rat::TriggerComponent::Overlaping);
+			triggers.push_back(trigger);
+		}
+
+		player = scene->addRawEntity("single");
+		scene->setPlayer(player);
+	}
+
+	/// Triggers containing player, checked one by one
+	std::vector<rat::TriggerComponent*> findOverlaps() const
+	{
+		std::vector<rat::TriggerComponent*> result;
+		for (auto* trigger : triggers) {
+			if (trigger->checkForTrigger(player->getPosition())) {
+				result.push_back(trigger);
+			}
+		}
+		return result;
+	}
+};
+
+/// Player walks in and out of triggers and then far away from them, only triggers in its cells are checked. Each overlap change has to call one event
+TEST_F(TriggersBenchmark, Walk)
+{
+	auto& system = scene->getTriggers();
+
+	std::vector<rat::TriggerComponent*> previous;
+	size_t overlaps = 0;
+	size_t enters = 0;
+	size_t leaves = 0;
+	float time = 0.f;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		// Half of steps end between triggers
+		const float x = frame < framesCount / 2 ? frame * 150.f : -100000.f;
+		player->setPosition({ x, 0.f, 0.f });
+
+		rat::Clock clock;
+		scene->update(1.f / 60.f);
+		system.update();
+		time += clock.getElapsedTime().asFSeconds();
+
+		const auto current = findOverlaps();
+		const size_t entered = std::count_if(current.begin(), current.end(), [&](auto* trigger) {
+			return std::find(previous.begin(), previous.end(), trigger) == previous.end();
+		});
+		const size_t left = std::count_if(previous.begin(), previous.end(), [&](auto* trigger) {
+			return std::find(current.begin(), current.end(), trigger) == current.end();
+		});
+
+		if (system.getOverlapsCount() != current.size()) {
+			throw std::runtime_error("Trigger system found other overlaps than brute force");
+		}
+		if (system.getEnterEventsCount() != entered || system.getLeaveEventsCount() != left) {
+			throw std::runtime_error("Trigger events do not match overlap changes");
+		}
+
+		overlaps += current.size();
+		enters += entered;
+		leaves += left;
+		previous = current;
+	}
+
+	if (enters == 0 || enters != leaves) {
+		throw std::runtime_error("Every entered trigger has to be left once");
+	}
+
+	LOG_INFO("Triggers of ", triggersCount, " entities: ", perFrame(time), " ms per frame, ", overlaps, " overlaps");
+}
@@ -0,0 +1,38 @@
+#pragma once
+
+#include "Szczur/Modules/World/World.hpp"
+#include "Szczur/Utility/Tests.hpp"
+
+/// Scene added only for one test
+struct WorldBenchmark : public ::testing::Test
+{
+	static constexpr size_t framesCount = 100;
+
+	rat::ScenesManager* scenes;
+	rat::Scene* scene;
+
+	virtual void SetUp()
+	{
+		scenes = &rat::detail::globalPtr<rat::World>->getScenes();
+		scene = scenes->addScene();
+	}
+
+	virtual void TearDown()
+	{
+		scenes->removeScene(scene->getID());
+	}
+
+	/// Entity spread along wide path level, in rows of 100
+	rat::Entity* addOnPath(size_t index)
+	{
+		auto* entity = scene->addRawEntity("path");
+		entity->setPosition({ (index % 100) * 300.f, 0.f, (index / 100) * 300.f });
+		return entity;
+	}
+
+	/// Milliseconds of one frame from seconds of all frames
+	static float perFrame(float seconds)
+	{
+		return seconds * 1000.f / framesCount;
+	}
+};
@@ -0,0 +1,152 @@
+#include "TriggerSystem.hpp"
+
+#include <algorithm>
+
+#include "Szczur/Utility/Profiler.hpp"
+
+#include "Scene.hpp"
+#include "Components/TriggerComponent.hpp"
+
+namespace rat
+{
+
+TriggerSystem::TriggerSystem(Scene* scene)
+	: _scene { scene }
+{
+
+}
+
+void TriggerSystem::addSubject(Entity* entity)
+{
+	if (!isSubject(entity))
+	{
+		_subjects.push_back(entity->getID());
+	}
+}
+
+void TriggerSystem::removeSubject(Entity* entity)
+{
+	_subjects.erase(std::remove(_subjects.begin(), _subjects.end(), entity->getID()), _subjects.end());
+}
+
+bool TriggerSystem::isSubject(const Entity* entity) const
+{
+	return std::find(_subjects.begin(), _subjects.end(), entity->getID()) != _subjects.end();
+}
+
+void TriggerSystem::update()
+{
+	PROFILE_FUNCTION();
+
+	_newOverlaps.clear();
+
+	// Subjects removed from scene are forgotten, their overlaps end without events
+	_subjects.erase(std::remove_if(_subjects.begin(), _subjects.end(), [this](size_t id) {
+		return _scene->getEntity(id) == nullptr;
+	}), _subjects.end());
+
+	for (size_t id : _subjects)
+	{
+		_findOverlaps(_scene->getEntity(id));
+	}
+
+	if (Entity* player = _scene->getPlayer(); player && !isSubject(player))
+	{
+		_findOverlaps(player);
+	}
+
+	std::sort(_newOverlaps.begin(), _newOverlaps.end());
+
+	// Callbacks may move entities or add subjects, so events are called after all queries
+	std::swap(_overlaps, _newOverlaps);
+	const auto& previous = _newOverlaps;
+	const auto& current = _overlaps;
+
+	auto call = [this](const Overlap& overlap, auto event) {
+		Entity* triggerEntity = _scene->getEntity(overlap.trigger);
+		Entity* subject = _scene->getEntity(overlap.subject);
+		if (!triggerEntity || !subject)
+		{
+			return;
+		}
+
+		if (auto* trigger = triggerEntity->getComponentAs<TriggerComponent>())
+		{
+			(trigger->*event)(subject);
+		}
+	};
+
+	_enterEventsCount = 0;
+	_leaveEventsCount = 0;
+
+	size_t i = 0;
+	size_t j = 0;
+	while (i < previous.size() || j < current.size())
+	{
+		if (j == current.size() || (i < previous.size() && previous[i] < current[j]))
+		{
+			call(previous[i++], &TriggerComponent::onLeave);
+			++_leaveEventsCount;
+		}
+		else if (i == previous.size() || current[j] < previous[i])
+		{
+			call(current[j], &TriggerComponent::onEnter);
+			call(current[j++], &TriggerComponent::onInside);
+			++_enterEventsCount;
+		}
+		else
+		{
+			call(current[j++], &TriggerComponent::onInside);
+			++i;
+		}
+	}
+}
+
+void TriggerSystem::clear()
+{
+	_overlaps.clear();
+}
+
+size_t TriggerSystem::getOverlapsCount() const
+{
+	return _overlaps.size();
+}
+
+size_t TriggerSystem::getEnterEventsCount() const
+{
+	return _enterEventsCount;
+}
+
+size_t TriggerSystem::getLeaveEventsCount() const
+{
+	return _leaveEventsCount;
+}
+
+void TriggerSystem::_findOverlaps(Entity* subject)
+{
+	if (!subject->exists() || !subject->isActive())
+	{
+		return;
+	}
+
+	// Only triggers in cells of subject are checked against their shapes
+	const glm::vec3 position = subject->getPosition();
+	const SpatialHash::Rect_t point { position.x, position.z, position.x, position.z };
+
+	_scene->getSpatialHash().query(point, SpatialHash::Triggers, [&](Component* component) {
+		auto* trigger = static_cast<TriggerComponent*>(component);
+		Entity* triggerEntity = trigger->getEntity();
+
+		if (triggerEntity == subject || !triggerEntity->exists() || !triggerEntity->isActive())
+		{
+			return;
+		}
+
+		if (trigger->checkForTrigger(position))
+		{
+			_newOverlaps.push_back({ triggerEntity->getID(), subject->getID() });
+		}
+	});
+}
+
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <vector>
+
+namespace rat
+{
+
+// FWD
+class Entity;
+class Scene;
+
+/// Finds which subjects are inside trigger volumes of scene, using its spatial hash. Triggers get enter and leave events only when overlap changes
+class TriggerSystem
+{
+public:
+
+	///
+	TriggerSystem(Scene* scene);
+
+	// Non-copyable
+	TriggerSystem(const TriggerSystem&) = delete;
+	TriggerSystem& operator = (const TriggerSystem&) = delete;
+
+	/// Entity which sets off triggers, player of scene always does
+	void addSubject(Entity* entity);
+
+	///
+	void removeSubject(Entity* entity);
+
+	///
+	bool isSubject(const Entity* entity) const;
+
+	/// Queries triggers around each subject and calls events of changed overlaps, after all queries are done
+	void update();
+
+	/// Forgets overlaps without calling leave events
+	void clear();
+
+	/// Number of trigger and subject pairs overlapping since last update
+	size_t getOverlapsCount() const;
+
+	/// Number of enter events called in last update
+	size_t getEnterEventsCount() const;
+
+	/// Number of leave events called in last update
+	size_t getLeaveEventsCount() const;
+
+private:
+
+	/// Pair of entity IDs, IDs stay valid when entities are removed
+	struct Overlap
+	{
+		size_t trigger;
+		size_t subject;
+
+		bool operator < (const Overlap& other) const
+		{
+			return trigger < other.trigger || (trigger == other.trigger && subject < other.subject);
+		}
+
+		bool operator == (const Overlap& other) const
+		{
+			return trigger == other.trigger && subject == other.subject;
+		}
+	};
+
+	///
+	void _findOverlaps(Entity* subject);
+
+	Scene* _scene;
+
+	std::vector<size_t> _subjects;
+
+	// Sorted, compared with each other to find changes
+	std::vector<Overlap> _overlaps;
+	std::vector<Overlap> _newOverlaps;
+
+	size_t _enterEventsCount = 0;
+	size_t _leaveEventsCount = 0;
+
+};
+
+}
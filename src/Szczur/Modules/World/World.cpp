@@ -1,6 +1,7 @@
 #include "World.hpp"
 
 #include <Szczur/Modules/World/Data/TextureDataHolder.hpp>
+#include <Szczur/Modules/World/Data/ArmatureDataCache.hpp>
 
 namespace rat
 {
@@ -43,6 +44,11 @@ World::World()
 
 World::~World()
 {
+	// Armatures and their data are released while editor, factory and graphics context still exist
+	_scenes.removeAllScenes();
+	_scenes.getArmatureDisplayDataHolder().clear();
+	ArmatureDataCache::get().clear();
+
 	LOG_INFO("Module World destructed");
 }
 
@@ -53,6 +59,7 @@ void World::update(float deltaTime)
 	}
 	if (getScenes().isCurrentSceneValid())
 	{
+		getScenes().updateStreaming();
 		getScenes().getCurrentScene()->update(deltaTime);
 	}
 	#ifdef EDITOR
@@ -98,6 +105,8 @@ void World::render()
 {
 	auto& target = getModule<Window>().getWindow();
 
+	target.resetStatistics();
+
 	if (getScenes().isCurrentSceneValid())
 	{
 		getScenes().getCurrentScene()->draw(target);
@@ -147,6 +156,9 @@ void World::fadeIntoScene(size_t id, float fadeTime)
 	_sceneToChange = id;
 	_fadeTime = fadeTime;
 	_fadeStart.restart();
+
+	// Target scene is loaded while screen fades, its textures are decoded in background
+	_scenes.preloadScene(id);
 }
 
 void World::initScript() {
@@ -167,6 +179,17 @@ void World::initScript() {
 		[&] (const std::string& name, float fadeTime = 1.f) {fadeIntoScene(_scenes.getScene(name)->getID(), fadeTime); }
 	));
 
+	module.set_function("preloadScene", sol::overload(
+		[&] (Scene* scene) {_scenes.preloadScene(scene->getID()); },
+		[&] (const std::string& name) {_scenes.preloadScene(_scenes.getScene(name)->getID()); }
+	));
+	module.set_function("unloadScene", sol::overload(
+		[&] (Scene* scene) {return _scenes.unloadScene(scene->getID()); },
+		[&] (const std::string& name) {return _scenes.unloadScene(_scenes.getScene(name)->getID()); }
+	));
+	module.set_function("setStreamingDistance", [&](size_t hops){_scenes.setStreamingDistance(hops);});
+	module.set_function("setStreamingBudget", [&](size_t bytes){_scenes.setStreamingBudget(bytes);});
+
 	module.set_function("getTextureDataHolder", [&](){return std::ref(getScenes().getTextureDataHolder());});
 
 	script.initClasses<Entity, Scene, TextureDataHolder>();
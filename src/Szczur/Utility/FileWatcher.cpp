@@ -0,0 +1,257 @@
+#include "FileWatcher.hpp"
+
+#include <algorithm>
+#include <vector>
+
+#ifdef OS_LINUX
+#	include <sys/inotify.h>
+#	include <unistd.h>
+#	include <cerrno>
+#	include <cstring>
+#else
+#	include <chrono>
+#endif
+
+#include "Szczur/Utility/Logger.hpp"
+
+namespace rat
+{
+
+FileWatcher::FileWatcher()
+{
+#ifdef OS_LINUX
+	_inotify = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (_inotify < 0) {
+		LOG_ERROR("Cannot initialize inotify: ", std::strerror(errno));
+	}
+#endif
+}
+
+FileWatcher::~FileWatcher()
+{
+#ifdef OS_LINUX
+	if (_inotify >= 0) {
+		close(_inotify);
+	}
+#else
+	{
+		std::lock_guard<std::mutex> lock(_mutex);
+		_stop = true;
+	}
+	_condition.notify_all();
+	if (_thread.joinable()) {
+		_thread.join();
+	}
+#endif
+}
+
+FileWatcher& FileWatcher::get()
+{
+	static FileWatcher instance;
+	return instance;
+}
+
+FileWatcher::WatchID_t FileWatcher::watch(const std::string& path, Callback_t callback)
+{
+	auto normalized = _normalize(path);
+
+#ifdef OS_LINUX
+	const auto slash = normalized.find_last_of('/');
+	_watchDirectory(slash == std::string::npos ? "." : normalized.substr(0, slash));
+#else
+	{
+		namespace fs = std::experimental::filesystem;
+
+		std::error_code error;
+		auto time = fs::last_write_time(normalized, error);
+
+		std::lock_guard<std::mutex> lock(_mutex);
+		_times.emplace(normalized, error ? fs::file_time_type::min() : time);
+	}
+	if (!_thread.joinable()) {
+		_thread = std::thread(&FileWatcher::_pollLoop, this);
+	}
+#endif
+
+	const auto id = ++_lastID;
+	_byPath.emplace(normalized, id);
+	_watches.emplace(id, Watch{ std::move(normalized), std::move(callback) });
+	return id;
+}
+
+void FileWatcher::unwatch(WatchID_t id)
+{
+	auto it = _watches.find(id);
+	if (it == _watches.end()) {
+		return;
+	}
+
+	auto range = _byPath.equal_range(it->second.path);
+	for (auto pathIt = range.first; pathIt != range.second; ++pathIt) {
+		if (pathIt->second == id) {
+			_byPath.erase(pathIt);
+			break;
+		}
+	}
+
+#ifndef OS_LINUX
+	if (_byPath.count(it->second.path) == 0) {
+		std::lock_guard<std::mutex> lock(_mutex);
+		_times.erase(it->second.path);
+	}
+#endif
+
+	_watches.erase(it);
+}
+
+void FileWatcher::applyChanges()
+{
+	std::unordered_set<std::string> changed;
+	_collectChanges(changed);
+
+	for (auto& path : changed) {
+		LOG_INFO("File changed: ", path);
+
+		// Callbacks may add or remove watches, so identifiers are copied first
+		std::vector<WatchID_t> ids;
+		auto range = _byPath.equal_range(path);
+		for (auto it = range.first; it != range.second; ++it) {
+			ids.push_back(it->second);
+		}
+
+		for (auto id : ids) {
+			if (auto it = _watches.find(id); it != _watches.end()) {
+				try {
+					// Copy, callback is allowed to unwatch itself
+					auto callback = it->second.callback;
+					callback(path);
+				}
+				catch (const std::exception& exc) {
+					LOG_EXCEPTION(exc);
+				}
+			}
+		}
+	}
+}
+
+std::size_t FileWatcher::getWatchesCount() const
+{
+	return _watches.size();
+}
+
+std::string FileWatcher::_normalize(const std::string& path)
+{
+	std::string result = path;
+	std::replace(result.begin(), result.end(), '\\', '/');
+
+	// Collapse repeated slashes
+	result.erase(std::unique(result.begin(), result.end(), [](char a, char b) {
+		return a == '/' && b == '/';
+	}), result.end());
+
+	while (result.compare(0, 2, "./") == 0) {
+		result.erase(0, 2);
+	}
+	return result;
+}
+
+#ifdef OS_LINUX
+
+void FileWatcher::_watchDirectory(const std::string& directory)
+{
+	if (_inotify < 0) {
+		return;
+	}
+
+	// Same directory gives same descriptor, so it is safe to add it again
+	const int descriptor = inotify_add_watch(_inotify, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO | IN_CREATE);
+	if (descriptor < 0) {
+		LOG_WARNING("Cannot watch directory ", directory, ": ", std::strerror(errno));
+		return;
+	}
+	_directories[descriptor] = directory;
+}
+
+void FileWatcher::_collectChanges(std::unordered_set<std::string>& changed)
+{
+	if (_inotify < 0) {
+		return;
+	}
+
+	alignas(inotify_event) char buffer[4096];
+	while (true) {
+		const ssize_t length = read(_inotify, buffer, sizeof(buffer));
+		if (length <= 0) {
+			break;
+		}
+
+		for (ssize_t offset = 0; offset < length;) {
+			const auto* event = reinterpret_cast<const inotify_event*>(buffer + offset);
+			offset += sizeof(inotify_event) + event->len;
+
+			// Events were lost, so everything is treated as changed
+			if (event->mask & IN_Q_OVERFLOW) {
+				for (auto& [path, id] : _byPath) {
+					changed.insert(path);
+				}
+				continue;
+			}
+
+			auto directory = _directories.find(event->wd);
+			if (event->len == 0 || directory == _directories.end()) {
+				continue;
+			}
+
+			std::string path = directory->second == "." ? event->name : directory->second + "/" + event->name;
+			if (_byPath.count(path)) {
+				changed.insert(std::move(path));
+			}
+		}
+	}
+}
+
+#else
+
+void FileWatcher::_collectChanges(std::unordered_set<std::string>& changed)
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+	changed.swap(_pending);
+}
+
+void FileWatcher::_pollLoop()
+{
+	namespace fs = std::experimental::filesystem;
+
+	std::unique_lock<std::mutex> lock(_mutex);
+	while (!_condition.wait_for(lock, std::chrono::milliseconds(500), [this] { return _stop; })) {
+		std::vector<std::string> paths;
+		paths.reserve(_times.size());
+		for (auto& [path, time] : _times) {
+			paths.push_back(path);
+		}
+
+		// Disk is checked without lock
+		std::vector<std::pair<std::string, fs::file_time_type>> times;
+		lock.unlock();
+		for (auto& path : paths) {
+			std::error_code error;
+			auto time = fs::last_write_time(path, error);
+			if (!error) {
+				times.emplace_back(std::move(path), time);
+			}
+		}
+		lock.lock();
+
+		for (auto& [path, time] : times) {
+			auto it = _times.find(path);
+			if (it != _times.end() && it->second != time) {
+				it->second = time;
+				_pending.insert(path);
+			}
+		}
+	}
+}
+
+#endif
+
+}
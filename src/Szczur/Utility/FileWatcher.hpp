@@ -0,0 +1,91 @@
+#pragma once
+
+#include "Szczur/Config.hpp"
+
+#include <functional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+
+#ifndef OS_LINUX
+#	include <condition_variable>
+#	include <experimental/filesystem>
+#	include <mutex>
+#	include <thread>
+#endif
+
+namespace rat
+{
+
+/// Watches files for changes and calls callbacks once per frame, so lookups never touch disk
+class FileWatcher
+{
+public:
+
+	using Callback_t = std::function<void(const std::string&)>;
+	using WatchID_t  = std::size_t;
+
+	///
+	FileWatcher();
+
+	// Non-copyable
+	FileWatcher(const FileWatcher&) = delete;
+	FileWatcher& operator = (const FileWatcher&) = delete;
+
+	///
+	~FileWatcher();
+
+	///
+	static FileWatcher& get();
+
+	/// Registers callback called from `applyChanges` after file is modified
+	WatchID_t watch(const std::string& path, Callback_t callback);
+
+	/// Removes callback, 0 is ignored
+	void unwatch(WatchID_t id);
+
+	/// Calls callbacks of files changed since last call, each file once, should be called once per frame
+	void applyChanges();
+
+	/// Number of registered callbacks
+	std::size_t getWatchesCount() const;
+
+private:
+
+	struct Watch
+	{
+		std::string path;
+		Callback_t callback;
+	};
+
+	///
+	static std::string _normalize(const std::string& path);
+
+	/// Moves paths changed since last call to `changed`
+	void _collectChanges(std::unordered_set<std::string>& changed);
+
+	WatchID_t _lastID = 0;
+	std::unordered_map<WatchID_t, Watch> _watches;
+	std::unordered_multimap<std::string, WatchID_t> _byPath;
+
+#ifdef OS_LINUX
+	/// Directories are watched instead of files, so files replaced on save are noticed too
+	void _watchDirectory(const std::string& directory);
+
+	int _inotify = -1;
+	std::unordered_map<int, std::string> _directories;
+#else
+	/// Polls modification times in separate thread, where inotify is not available
+	void _pollLoop();
+
+	std::unordered_map<std::string, std::experimental::filesystem::file_time_type> _times;
+	std::unordered_set<std::string> _pending;
+	std::thread _thread;
+	std::mutex _mutex;
+	std::condition_variable _condition;
+	bool _stop = false;
+#endif
+
+};
+
+}
@@ -0,0 +1,213 @@
+#include "JobSystem.hpp"
+
+#include <algorithm>
+#include <exception>
+#include <limits>
+#include <string>
+
+#include "Profiler.hpp"
+
+namespace rat
+{
+
+namespace
+{
+	constexpr size_t NotWorker = std::numeric_limits<size_t>::max();
+}
+
+thread_local size_t JobSystem::_workerIndex = NotWorker;
+
+JobSystem::JobSystem()
+{
+	// Workers name themselves in profiler, it has to be destroyed after them
+	Profiler::get();
+
+	// Main thread also works while waiting for jobs
+	const size_t cores = std::thread::hardware_concurrency();
+	_startWorkers(cores > 1 ? cores - 1 : 0);
+}
+
+JobSystem::~JobSystem()
+{
+	_stopWorkers();
+}
+
+JobSystem& JobSystem::get()
+{
+	static JobSystem instance;
+	return instance;
+}
+
+void JobSystem::setWorkersCount(size_t count)
+{
+	if (count == _workers.size()) {
+		return;
+	}
+
+	_stopWorkers();
+	_startWorkers(count);
+}
+
+size_t JobSystem::getWorkersCount() const
+{
+	return _workers.size();
+}
+
+void JobSystem::setDeterministic(bool deterministic)
+{
+	_deterministic.store(deterministic, std::memory_order_relaxed);
+}
+
+bool JobSystem::isDeterministic() const
+{
+	return _deterministic.load(std::memory_order_relaxed);
+}
+
+void JobSystem::parallelFor(size_t count, size_t grain, const Range_t& function)
+{
+	grain = std::max<size_t>(grain, 1);
+
+	if (count <= grain || _workers.empty() || isDeterministic()) {
+		for (size_t begin = 0; begin < count; begin += grain) {
+			function(begin, std::min(begin + grain, count));
+		}
+		return;
+	}
+
+	std::atomic<size_t> remaining { (count + grain - 1) / grain };
+	std::exception_ptr exception;
+	std::mutex exceptionMutex;
+
+	for (size_t begin = 0; begin < count; begin += grain) {
+		const size_t end = std::min(begin + grain, count);
+		_push([&, begin, end] {
+			try {
+				function(begin, end);
+			}
+			catch (...) {
+				std::lock_guard<std::mutex> lock(exceptionMutex);
+				if (!exception) {
+					exception = std::current_exception();
+				}
+			}
+			remaining.fetch_sub(1, std::memory_order_acq_rel);
+		});
+	}
+
+	// Jobs of other batches may be run here too, they finish on their own
+	while (remaining.load(std::memory_order_acquire) > 0) {
+		if (!_tryRunJob()) {
+			std::this_thread::yield();
+		}
+	}
+
+	if (exception) {
+		std::rethrow_exception(exception);
+	}
+}
+
+void JobSystem::_startWorkers(size_t count)
+{
+	_stopping = false;
+
+	for (size_t i = 0; i < count; ++i) {
+		_workers.push_back(std::make_unique<Worker>());
+	}
+
+	// Started after all queues exist, workers steal from each other
+	for (size_t i = 0; i < count; ++i) {
+		_workers[i]->thread = std::thread(&JobSystem::_workerLoop, this, i);
+	}
+}
+
+void JobSystem::_stopWorkers()
+{
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_stopping = true;
+	}
+	_wakeUp.notify_all();
+
+	for (auto& worker : _workers) {
+		worker->thread.join();
+	}
+	_workers.clear();
+}
+
+void JobSystem::_workerLoop(size_t index)
+{
+	_workerIndex = index;
+	Profiler::get().setThreadName("Worker " + std::to_string(index));
+
+	while (true) {
+		if (_tryRunJob()) {
+			continue;
+		}
+
+		std::unique_lock<std::mutex> lock(_sleepMutex);
+		_wakeUp.wait(lock, [this] {
+			return _stopping || _queuedJobs.load(std::memory_order_acquire) > 0;
+		});
+
+		if (_stopping) {
+			return;
+		}
+	}
+}
+
+void JobSystem::_push(Job_t job)
+{
+	// Workers push to own queue, so nested jobs stay near their data
+	size_t index = _workerIndex;
+	if (index >= _workers.size()) {
+		index = _nextWorker.fetch_add(1, std::memory_order_relaxed) % _workers.size();
+	}
+
+	{
+		auto& worker = *_workers[index];
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		worker.jobs.push_back(std::move(job));
+	}
+
+	{
+		std::lock_guard<std::mutex> lock(_sleepMutex);
+		_queuedJobs.fetch_add(1, std::memory_order_release);
+	}
+	_wakeUp.notify_one();
+}
+
+bool JobSystem::_tryRunJob()
+{
+	const size_t count = _workers.size();
+	const size_t own = _workerIndex < count ? _workerIndex : 0;
+
+	Job_t job;
+	for (size_t i = 0; i < count && !job; ++i) {
+		const size_t index = (own + i) % count;
+		auto& worker = *_workers[index];
+
+		std::lock_guard<std::mutex> lock(worker.mutex);
+		if (worker.jobs.empty()) {
+			continue;
+		}
+
+		if (index == _workerIndex) {
+			job = std::move(worker.jobs.back());
+			worker.jobs.pop_back();
+		}
+		else {
+			job = std::move(worker.jobs.front());
+			worker.jobs.pop_front();
+		}
+	}
+
+	if (!job) {
+		return false;
+	}
+
+	_queuedJobs.fetch_sub(1, std::memory_order_acq_rel);
+	job();
+	return true;
+}
+
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace rat
+{
+
+/// Work-stealing thread pool, each worker takes newest jobs from its own queue and steals oldest from others
+class JobSystem
+{
+public:
+
+	using Job_t = std::function<void()>;
+	using Range_t = std::function<void(size_t, size_t)>;
+
+	///
+	JobSystem();
+
+	// Non-copyable
+	JobSystem(const JobSystem&) = delete;
+	JobSystem& operator = (const JobSystem&) = delete;
+
+	///
+	~JobSystem();
+
+	///
+	static JobSystem& get();
+
+	/// Restarts workers, 0 runs all jobs on calling thread. Must not be called while jobs are running
+	void setWorkersCount(size_t count);
+
+	///
+	size_t getWorkersCount() const;
+
+	/// Runs jobs in order on calling thread, for debugging races and reproducing bugs
+	void setDeterministic(bool deterministic);
+
+	///
+	bool isDeterministic() const;
+
+	/// Calls function for ranges of at most grain indices from [0, count), returns when all are done. Calling thread helps with work, first exception is rethrown
+	void parallelFor(size_t count, size_t grain, const Range_t& function);
+
+private:
+
+	struct Worker
+	{
+		std::thread thread;
+		std::mutex mutex;
+		std::deque<Job_t> jobs;
+	};
+
+	///
+	void _startWorkers(size_t count);
+
+	///
+	void _stopWorkers();
+
+	///
+	void _workerLoop(size_t index);
+
+	///
+	void _push(Job_t job);
+
+	/// Own queue first, then steals, returns false when all queues are empty
+	bool _tryRunJob();
+
+	static thread_local size_t _workerIndex;
+
+	std::vector<std::unique_ptr<Worker>> _workers;
+	std::atomic<size_t> _nextWorker { 0 };
+	std::atomic<bool> _deterministic { false };
+
+	// Sleeping workers are woken when jobs are pushed
+	std::mutex _sleepMutex;
+	std::condition_variable _wakeUp;
+	std::atomic<size_t> _queuedJobs { 0 };
+	bool _stopping = false;
+
+};
+
+}
@@ -0,0 +1,183 @@
+#include "MappedFile.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+#ifdef OS_WINDOWS
+#	include <windows.h>
+#else
+#	include <fcntl.h>
+#	include <sys/mman.h>
+#	include <sys/stat.h>
+#	include <unistd.h>
+#endif
+
+namespace rat
+{
+
+MappedFile::MappedFile(const std::string& path)
+{
+	open(path);
+}
+
+MappedFile::MappedFile(MappedFile&& rhs) noexcept
+{
+	*this = std::move(rhs);
+}
+
+MappedFile& MappedFile::operator = (MappedFile&& rhs) noexcept
+{
+	if (this != &rhs)
+	{
+		close();
+
+		std::swap(_data, rhs._data);
+		std::swap(_size, rhs._size);
+		std::swap(_isOpen, rhs._isOpen);
+#ifdef OS_WINDOWS
+		std::swap(_file, rhs._file);
+		std::swap(_mapping, rhs._mapping);
+#endif
+	}
+
+	return *this;
+}
+
+MappedFile::~MappedFile()
+{
+	close();
+}
+
+void MappedFile::open(const std::string& path)
+{
+	close();
+
+#ifdef OS_WINDOWS
+	_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (_file == INVALID_HANDLE_VALUE)
+	{
+		_file = nullptr;
+		throw std::runtime_error("Cannot open file " + path);
+	}
+
+	LARGE_INTEGER size;
+	GetFileSizeEx(_file, &size);
+	_size = static_cast<std::size_t>(size.QuadPart);
+
+	// Empty files cannot be mapped, but are valid
+	if (_size == 0)
+	{
+		_isOpen = true;
+		return;
+	}
+
+	_mapping = CreateFileMappingA(_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	if (_mapping == nullptr)
+	{
+		close();
+		throw std::runtime_error("Cannot map file " + path);
+	}
+
+	_data = static_cast<const std::uint8_t*>(MapViewOfFile(_mapping, FILE_MAP_READ, 0, 0, 0));
+	if (_data == nullptr)
+	{
+		close();
+		throw std::runtime_error("Cannot map file " + path);
+	}
+
+	_isOpen = true;
+#else
+	const int descriptor = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+	if (descriptor < 0)
+	{
+		throw std::runtime_error("Cannot open file " + path);
+	}
+
+	struct stat info;
+	if (fstat(descriptor, &info) != 0)
+	{
+		::close(descriptor);
+		throw std::runtime_error("Cannot read size of file " + path);
+	}
+	_size = static_cast<std::size_t>(info.st_size);
+
+	// Empty files cannot be mapped, but are valid
+	if (_size > 0)
+	{
+		void* data = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, descriptor, 0);
+		if (data == MAP_FAILED)
+		{
+			::close(descriptor);
+			_size = 0;
+			throw std::runtime_error("Cannot map file " + path);
+		}
+		_data = static_cast<const std::uint8_t*>(data);
+	}
+
+	// Mapping stays valid after closing descriptor
+	::close(descriptor);
+
+	_isOpen = true;
+#endif
+}
+
+void MappedFile::close()
+{
+#ifdef OS_WINDOWS
+	if (_data)
+	{
+		UnmapViewOfFile(_data);
+	}
+	if (_mapping)
+	{
+		CloseHandle(_mapping);
+	}
+	if (_file)
+	{
+		CloseHandle(_file);
+	}
+	_mapping = nullptr;
+	_file = nullptr;
+#else
+	if (_data)
+	{
+		munmap(const_cast<std::uint8_t*>(_data), _size);
+	}
+#endif
+
+	_data = nullptr;
+	_size = 0;
+	_isOpen = false;
+}
+
+bool MappedFile::isOpen() const
+{
+	return _isOpen;
+}
+
+const std::uint8_t* MappedFile::getData() const
+{
+	return _data;
+}
+
+std::size_t MappedFile::getSize() const
+{
+	return _size;
+}
+
+std::size_t MappedFile::getPageSize()
+{
+	static const std::size_t pageSize = [] {
+#ifdef OS_WINDOWS
+		SYSTEM_INFO info;
+		GetSystemInfo(&info);
+		return static_cast<std::size_t>(info.dwPageSize);
+#else
+		return static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+#endif
+	}();
+
+	return pageSize;
+}
+
+}
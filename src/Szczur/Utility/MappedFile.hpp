@@ -0,0 +1,65 @@
+#pragma once
+
+#include "Szczur/Config.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace rat
+{
+
+/// Read-only file mapped into memory, pages are read from disk only when touched
+class MappedFile
+{
+public:
+
+	///
+	MappedFile() = default;
+
+	/// Constructs and opens file
+	MappedFile(const std::string& path);
+
+	// Non-copyable
+	MappedFile(const MappedFile&) = delete;
+	MappedFile& operator = (const MappedFile&) = delete;
+
+	// Movable
+	MappedFile(MappedFile&& rhs) noexcept;
+	MappedFile& operator = (MappedFile&& rhs) noexcept;
+
+	///
+	~MappedFile();
+
+	/// Maps whole file, throws if it cannot be opened
+	void open(const std::string& path);
+
+	///
+	void close();
+
+	///
+	bool isOpen() const;
+
+	///
+	const std::uint8_t* getData() const;
+
+	///
+	std::size_t getSize() const;
+
+	/// Size of memory page, mapping is zero-filled after end of file up to multiple of it
+	static std::size_t getPageSize();
+
+private:
+
+	const std::uint8_t* _data = nullptr;
+	std::size_t _size = 0;
+	bool _isOpen = false;
+
+#ifdef OS_WINDOWS
+	void* _file = nullptr;
+	void* _mapping = nullptr;
+#endif
+
+};
+
+}
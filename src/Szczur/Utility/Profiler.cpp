@@ -0,0 +1,216 @@
+#include "Profiler.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <stdexcept>
+
+#include <nlohmann/json.hpp>
+
+namespace rat
+{
+
+namespace
+{
+	/// Zones near write position may be overwritten while copied
+	constexpr std::size_t SafetyMargin = 1024;
+}
+
+thread_local Profiler::ThreadBuffer* Profiler::_threadBuffer = nullptr;
+
+Profiler::Scope::Scope(const char* name)
+	: _name { Profiler::get().isEnabled() ? name : nullptr }
+	, _begin { 0 }
+{
+	if (_name) {
+		auto& profiler = Profiler::get();
+		++profiler._getThreadBuffer().depth;
+		_begin = profiler.now();
+	}
+}
+
+Profiler::Scope::~Scope()
+{
+	if (_name) {
+		auto& profiler = Profiler::get();
+		profiler._record(_name, _begin, profiler.now());
+	}
+}
+
+Profiler::Profiler()
+	: _start { std::chrono::steady_clock::now() }
+{
+
+}
+
+Profiler& Profiler::get()
+{
+	static Profiler instance;
+	return instance;
+}
+
+std::uint64_t Profiler::now() const
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - _start).count();
+}
+
+void Profiler::setEnabled(bool enabled)
+{
+	_enabled.store(enabled, std::memory_order_relaxed);
+}
+
+bool Profiler::isEnabled() const
+{
+	return _enabled.load(std::memory_order_relaxed);
+}
+
+void Profiler::setThreadName(const std::string& name)
+{
+	auto& buffer = _getThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	buffer.name = name;
+}
+
+void Profiler::beginFrame()
+{
+	_frameStarts[_framesStarted % _frameStarts.size()] = now();
+	++_framesStarted;
+}
+
+std::size_t Profiler::getFramesCount() const
+{
+	return _framesStarted == 0 ? 0 : std::min(_framesStarted - 1, FramesCount);
+}
+
+std::pair<std::uint64_t, std::uint64_t> Profiler::getFrame(std::size_t framesAgo) const
+{
+	if (framesAgo >= getFramesCount()) {
+		throw std::out_of_range("Frame is not in profiler history");
+	}
+
+	const std::size_t last = _framesStarted - 1 - framesAgo;
+	return { _frameStarts[(last - 1) % _frameStarts.size()], _frameStarts[last % _frameStarts.size()] };
+}
+
+std::vector<Profiler::ThreadZones> Profiler::collect(std::uint64_t begin, std::uint64_t end) const
+{
+	std::lock_guard<std::mutex> lock(_mutex);
+
+	std::vector<ThreadZones> result;
+	result.reserve(_buffers.size());
+	for (auto& buffer : _buffers) {
+		auto& thread = result.emplace_back(ThreadZones{ buffer->name, buffer->id, {} });
+
+		const std::uint64_t written = buffer->written.load(std::memory_order_acquire);
+		const std::uint64_t first = written > BufferSize - SafetyMargin ? written - (BufferSize - SafetyMargin) : 0;
+		for (std::uint64_t i = first; i < written; ++i) {
+			const Zone& zone = buffer->zones[i % BufferSize];
+			if (zone.end >= begin && zone.begin <= end) {
+				thread.zones.push_back(zone);
+			}
+		}
+
+		// Zones are written when they end, so parents come after children
+		std::sort(thread.zones.begin(), thread.zones.end(), [](const Zone& a, const Zone& b) {
+			return a.begin != b.begin ? a.begin < b.begin : a.depth < b.depth;
+		});
+	}
+	return result;
+}
+
+void Profiler::saveChromeTrace(const std::string& path) const
+{
+	using Json = nlohmann::json;
+
+	Json events = Json::array();
+	for (auto& thread : collect(0, now())) {
+		events.push_back({
+			{ "name", "thread_name" }, { "ph", "M" }, { "pid", 0 }, { "tid", thread.id },
+			{ "args", { { "name", thread.name } } }
+		});
+
+		for (auto& zone : thread.zones) {
+			events.push_back({
+				{ "name", zone.name }, { "ph", "X" }, { "pid", 0 }, { "tid", thread.id },
+				{ "ts", zone.begin / 1000.0 }, { "dur", (zone.end - zone.begin) / 1000.0 }
+			});
+		}
+	}
+
+	std::ofstream file{ path };
+	if (!file) {
+		throw std::runtime_error("Cannot save profiler trace to " + path);
+	}
+	file << Json{ { "traceEvents", std::move(events) }, { "displayTimeUnit", "ms" } };
+}
+
+Profiler::ThreadExit::~ThreadExit()
+{
+	Profiler::get()._releaseThreadBuffer();
+}
+
+Profiler::ThreadBuffer& Profiler::_getThreadBuffer()
+{
+	if (!_threadBuffer) {
+		thread_local ThreadExit exit;
+
+		std::lock_guard<std::mutex> lock(_mutex);
+
+		// Restarted workers take buffers of ended ones, instead of allocating new
+		auto ended = std::find_if(_buffers.begin(), _buffers.end(), [](const auto& buffer) {
+			return buffer->ended;
+		});
+		if (ended != _buffers.end()) {
+			_threadBuffer = ended->get();
+			_threadBuffer->ended = false;
+			_threadBuffer->depth = 0;
+			_threadBuffer->name = "Thread " + std::to_string(_threadBuffer->id);
+			return *_threadBuffer;
+		}
+
+		auto buffer = std::make_unique<ThreadBuffer>();
+		buffer->id = _buffers.empty() ? 0 : _buffers.back()->id + 1;
+		buffer->name = "Thread " + std::to_string(buffer->id);
+		_threadBuffer = buffer.get();
+		_buffers.push_back(std::move(buffer));
+	}
+	return *_threadBuffer;
+}
+
+void Profiler::_releaseThreadBuffer()
+{
+	if (!_threadBuffer) {
+		return;
+	}
+
+	std::lock_guard<std::mutex> lock(_mutex);
+	_threadBuffer->ended = true;
+	_threadBuffer = nullptr;
+
+	// Buffers are kept after thread ends, so its zones can still be shown, but only few of them
+	std::size_t endedCount = std::count_if(_buffers.begin(), _buffers.end(), [](const auto& buffer) {
+		return buffer->ended;
+	});
+	for (auto it = _buffers.begin(); it != _buffers.end() && endedCount > EndedBuffersCount;) {
+		if ((*it)->ended) {
+			it = _buffers.erase(it);
+			--endedCount;
+		}
+		else {
+			++it;
+		}
+	}
+}
+
+void Profiler::_record(const char* name, std::uint64_t begin, std::uint64_t end)
+{
+	auto& buffer = _getThreadBuffer();
+	--buffer.depth;
+
+	// Only owning thread writes, so relaxed load is enough
+	const std::uint64_t index = buffer.written.load(std::memory_order_relaxed);
+	buffer.zones[index % BufferSize] = Zone{ name, begin, end, buffer.depth };
+	buffer.written.store(index + 1, std::memory_order_release);
+}
+
+}
@@ -0,0 +1,157 @@
+#pragma once
+
+#include "Szczur/Config.hpp"
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace rat
+{
+
+/// Hierarchical frame profiler, each thread records finished zones into its own ring buffer
+class Profiler
+{
+public:
+
+	/// Finished zone, times are in nanoseconds since profiler start
+	struct Zone
+	{
+		const char* name;
+		std::uint64_t begin;
+		std::uint64_t end;
+		std::uint32_t depth;
+	};
+
+	/// Zones recorded by one thread
+	struct ThreadZones
+	{
+		std::string name;
+		std::uint32_t id;
+		std::vector<Zone> zones;
+	};
+
+	/// Records zone from construction to destruction, name must outlive profiler
+	class Scope
+	{
+	public:
+
+		///
+		Scope(const char* name);
+
+		// Non-copyable
+		Scope(const Scope&) = delete;
+		Scope& operator = (const Scope&) = delete;
+
+		///
+		~Scope();
+
+	private:
+
+		const char* _name;
+		std::uint64_t _begin;
+
+	};
+
+	/// Zones kept per thread
+	static constexpr std::size_t BufferSize = 1 << 16;
+
+	/// Buffers of ended threads kept for history, new threads reuse them and oldest ones are freed over it
+	static constexpr std::size_t EndedBuffersCount = 8;
+
+	/// Frames kept for history
+	static constexpr std::size_t FramesCount = 256;
+
+	///
+	Profiler();
+
+	// Non-copyable
+	Profiler(const Profiler&) = delete;
+	Profiler& operator = (const Profiler&) = delete;
+
+	///
+	static Profiler& get();
+
+	/// Nanoseconds since profiler start
+	std::uint64_t now() const;
+
+	///
+	void setEnabled(bool enabled);
+
+	///
+	bool isEnabled() const;
+
+	/// Names calling thread in timeline and trace
+	void setThreadName(const std::string& name);
+
+	/// Marks start of new frame, should be called once per frame from main thread
+	void beginFrame();
+
+	/// Number of finished frames in history
+	std::size_t getFramesCount() const;
+
+	/// Begin and end of finished frame, 0 is the last one
+	std::pair<std::uint64_t, std::uint64_t> getFrame(std::size_t framesAgo) const;
+
+	/// Copies zones overlapping given time range from all threads
+	std::vector<ThreadZones> collect(std::uint64_t begin, std::uint64_t end) const;
+
+	/// Saves all recorded zones in Chrome trace format, it can be opened in chrome://tracing
+	void saveChromeTrace(const std::string& path) const;
+
+private:
+
+	struct ThreadBuffer
+	{
+		std::string name;
+		std::uint32_t id;
+		std::uint32_t depth = 0;
+		bool ended = false;
+		std::atomic<std::uint64_t> written { 0 };
+		std::array<Zone, BufferSize> zones;
+	};
+
+	/// Returns buffer of thread when it ends
+	struct ThreadExit
+	{
+		~ThreadExit();
+	};
+
+	///
+	ThreadBuffer& _getThreadBuffer();
+
+	///
+	void _releaseThreadBuffer();
+
+	///
+	void _record(const char* name, std::uint64_t begin, std::uint64_t end);
+
+	static thread_local ThreadBuffer* _threadBuffer;
+
+	std::chrono::steady_clock::time_point _start;
+	std::atomic<bool> _enabled { true };
+
+	mutable std::mutex _mutex;
+	std::vector<std::unique_ptr<ThreadBuffer>> _buffers;
+
+	std::array<std::uint64_t, FramesCount + 1> _frameStarts {};
+	std::size_t _framesStarted = 0;
+
+};
+
+}
+
+#ifdef PROFILER
+#	define PROFILE_CONCAT_IMPL(a, b) a##b
+#	define PROFILE_CONCAT(a, b) PROFILE_CONCAT_IMPL(a, b)
+#	define PROFILE_SCOPE(name) ::rat::Profiler::Scope PROFILE_CONCAT(profilerScope, __LINE__) { name }
+#	define PROFILE_FUNCTION() PROFILE_SCOPE(__func__)
+#else
+#	define PROFILE_SCOPE(name)
+#	define PROFILE_FUNCTION()
+#endif
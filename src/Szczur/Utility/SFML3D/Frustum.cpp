@@ -0,0 +1,63 @@
+#include "Frustum.hpp"
+
+/** @file Frustum.cpp
+ ** @description View volume used to skip objects which would not be visible.
+ **/
+
+#include <glm/geometric.hpp> // dot, length
+
+namespace sf3d
+{
+
+/* Operators */
+Frustum::Frustum()
+{
+	// Planes which every point is in front of
+	this->planes.fill(glm::vec4(0.f, 0.f, 0.f, 1.f));
+}
+
+Frustum::Frustum(const glm::mat4& worldToClip)
+{
+	// Gribb-Hartmann: clip space planes expressed with matrix rows
+	const glm::vec4 row0 {worldToClip[0][0], worldToClip[1][0], worldToClip[2][0], worldToClip[3][0]};
+	const glm::vec4 row1 {worldToClip[0][1], worldToClip[1][1], worldToClip[2][1], worldToClip[3][1]};
+	const glm::vec4 row2 {worldToClip[0][2], worldToClip[1][2], worldToClip[2][2], worldToClip[3][2]};
+	const glm::vec4 row3 {worldToClip[0][3], worldToClip[1][3], worldToClip[2][3], worldToClip[3][3]};
+
+	this->planes = {
+		row3 + row0, // Left
+		row3 - row0, // Right
+		row3 + row1, // Bottom
+		row3 - row1, // Top
+		row3 + row2, // Near
+		row3 - row2  // Far
+	};
+
+	for (glm::vec4& plane : this->planes) {
+		const float length = glm::length(glm::vec3(plane));
+		if (length > 0.f) {
+			plane /= length;
+		}
+	}
+}
+
+
+
+/* Methods */
+bool Frustum::intersects(const glm::vec3& boxMin, const glm::vec3& boxMax) const
+{
+	for (const glm::vec4& plane : this->planes) {
+		// Corner furthest along plane normal, box is outside if even it is behind the plane
+		const glm::vec3 corner {
+			plane.x >= 0.f ? boxMax.x : boxMin.x,
+			plane.y >= 0.f ? boxMax.y : boxMin.y,
+			plane.z >= 0.f ? boxMax.z : boxMin.z
+		};
+		if (glm::dot(glm::vec3(plane), corner) + plane.w < 0.f) {
+			return false;
+		}
+	}
+	return true;
+}
+
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+/** @file Frustum.hpp
+ ** @description View volume used to skip objects which would not be visible.
+ **/
+
+#include <array>
+
+#include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
+#include <glm/mat4x4.hpp>
+
+namespace sf3d
+{
+
+/// View volume described by planes, works for perspective and orthographic projections
+class Frustum
+{
+	/* Variables */
+private:
+	// Planes as { normal, distance }, normals point inside
+	std::array<glm::vec4, 6> planes;
+
+
+
+	/* Operators */
+public:
+	/// Volume which contains everything
+	Frustum();
+
+	/// Volume of clip space transformed back by given world to clip matrix
+	Frustum(const glm::mat4& worldToClip);
+
+
+
+	/* Methods */
+public:
+	/// Whether axis aligned box is at least partially inside, may be true for some boxes near corners
+	bool intersects(const glm::vec3& boxMin, const glm::vec3& boxMax) const;
+};
+
+}
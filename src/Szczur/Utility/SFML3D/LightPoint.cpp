@@ -5,7 +5,12 @@
  ** @author Patryk (PsychoX) Ludwikowski <psychoxivi+basementstudios@gmail.com>
  **/
 
+#include <algorithm> // max
+#include <cmath> // sqrt
+#include <limits>
+
 #include <glm/vec3.hpp>
+#include <glm/common.hpp> // max
 
 namespace sf3d
 {
@@ -67,4 +72,31 @@ void LightPoint::setSpecularFactor(const glm::vec3& factor)
 	this->specularFactor = factor;
 }
 
+
+
+
+/* Methods */
+float LightPoint::getAttenuationRadius(float threshold) const
+{
+	// Strongest channel of the light before attenuation, shader adds both factors when surface faces the light
+	const glm::vec3 factor = (this->ambientFactor + this->diffuseFactor) * this->color;
+	const float intensity = std::max({factor.x, factor.y, factor.z});
+
+	// Solve `constant + linear * d + quadratic * d^2 = intensity / threshold`
+	const float c = this->attenuation.constant - intensity / threshold;
+	const float l = this->attenuation.linear;
+	const float q = this->attenuation.quadratic;
+
+	if (c >= 0.f) {
+		return 0.f;
+	}
+	if (q > 0.f) {
+		return (-l + std::sqrt(l * l - 4.f * q * c)) / (2.f * q);
+	}
+	if (l > 0.f) {
+		return -c / l;
+	}
+	return std::numeric_limits<float>::infinity();
+}
+
 }
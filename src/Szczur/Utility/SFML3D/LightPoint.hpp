@@ -62,6 +62,13 @@ public:
     /// Specular factor
     glm::vec3 getSpecularFactor() const;
     void setSpecularFactor(const glm::vec3& factor);
+
+
+
+    /* Methods */
+public:
+    /// Distance at which contribution of the light drops below threshold, infinity if never
+    float getAttenuationRadius(float threshold = 1.f / 256.f) const;
 };
 
 }
@@ -1,19 +1,26 @@
 #include "RenderTarget.hpp"
 #include "Szczur/Utility/Logger.hpp"
+#include "Szczur/Utility/Profiler.hpp"
 
 /** @file RenderTarget.cpp
  ** @author Tomasz (Knayder) Jatkowski
  ** @author Patryk (PsychoX) Ludwikowski <psychoxivi+basementstudios@gmail.com>
  **/
 
-#include <cstdio> // snprintf
+#include <algorithm> // min, max, sort
+#include <cstddef> // offsetof
+#include <limits>
 #include <stdexcept>
 
 #define GLM_ENABLE_EXPERIMENTAL
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
 #include <glm/trigonometric.hpp>
 #include <glm/gtx/rotate_vector.hpp>
+#include <glm/gtc/matrix_transform.hpp> // scale
 #include <glad/glad.h>
 
 #include <SFML/Graphics/Color.hpp>
@@ -21,6 +28,7 @@
 #include "RenderStates.hpp"
 #include "Texture.hpp"
 #include "Camera.hpp"
+#include "Vertex.hpp"
 #include "VertexArray.hpp"
 #include "Drawable.hpp"
 #include "LightPoint.hpp"
@@ -72,6 +80,51 @@ void RenderTarget::setCamera(Camera& camera)
 {
 	this->setCamera(&camera);
 }
+Frustum RenderTarget::getViewFrustum() const
+{
+	// Shader scales positions and translations of model and view by `positionFactor`
+	const glm::mat4 scale = glm::scale(glm::mat4(1.f), glm::vec3(this->positionFactor));
+	return Frustum(this->camera->getProjectionMatrix() * scale * this->camera->getViewMatrix());
+}
+
+// Batching
+bool RenderTarget::isBatchingEnabled() const
+{
+	return this->batchingEnabled;
+}
+void RenderTarget::setBatchingEnabled(bool state)
+{
+	if (!state) {
+		this->endBatch();
+	}
+	this->batchingEnabled = state;
+}
+
+bool RenderTarget::isBatching() const
+{
+	return this->batching;
+}
+
+// Light culling
+std::size_t RenderTarget::getMaxLightPointsPerObject() const
+{
+	return this->maxLightPointsPerObject;
+}
+void RenderTarget::setMaxLightPointsPerObject(std::size_t count)
+{
+	this->maxLightPointsPerObject = std::min(count, maxLightPointsPerObjectLimit);
+}
+
+// Statistics
+const RenderStatistics& RenderTarget::getStatistics() const
+{
+	return this->statistics;
+}
+void RenderTarget::resetStatistics()
+{
+	this->statistics = RenderStatistics();
+	this->lastTextureID = 0;
+}
 
 
 
@@ -89,6 +142,18 @@ RenderTarget::~RenderTarget()
 	if (this->defaultCamera) {
 		delete defaultCamera;
 	}
+	if (this->batchVAO) {
+		glDeleteVertexArrays(1, &this->batchVAO);
+	}
+	if (this->batchVBO) {
+		glDeleteBuffers(1, &this->batchVBO);
+	}
+	if (this->batchEBO) {
+		glDeleteBuffers(1, &this->batchEBO);
+	}
+	if (this->lightPointsUBO) {
+		glDeleteBuffers(1, &this->lightPointsUBO);
+	}
 }
 
 
@@ -133,6 +198,7 @@ glm::mat4 RenderTarget::scaleMatrixCoords(glm::mat4 matrix)
 // Clearing
 void RenderTarget::clear(float r, float g, float b, float a, GLbitfield flags)
 {
+	this->flushBatch();
 	if (this->_setActive()) {
 		glClearColor(r, g, b, a);
 		glClear(flags);
@@ -141,6 +207,7 @@ void RenderTarget::clear(float r, float g, float b, float a, GLbitfield flags)
 }
 void RenderTarget::clear(const sf::Color& color, GLbitfield flags)
 {
+	this->flushBatch();
 	if (this->_setActive()) {
 		glClearColor(color.r / 255.f, color.g / 255.f, color.b / 255.f, color.a / 255.f);
 		glClear(flags);
@@ -161,62 +228,58 @@ void RenderTarget::draw(const Drawable& drawable)
 // Drawing vertices in perspective projection
 void RenderTarget::draw(const VertexArray& vertices, const RenderStates& states)
 {
-	if (vertices.getSize() > 0 && this->_setActive()) {
-		vertices.update();
+	PROFILE_SCOPE("RenderTarget::draw");
 
+	if (vertices.getSize() > 0 && this->_setActive()) {
 		// Shader selection
 		ShaderProgram* shaderProgram = (states.shader ? states.shader : this->defaultStates.shader);
 		if (!(shaderProgram && shaderProgram->isValid())) {
 			throw std::runtime_error("No shader available for rendering!");
 		}
 
-		// Shader configuration
-		{
-			glUseProgram(shaderProgram->getNativeHandle());
-
-			// For futher testing...
-			// LOG_INFO("vertices[0] = ", vertices[0].position, " ", vertices[0].color, " ", vertices[0].texCoord);
-			// LOG_INFO("vertices[1] = ", vertices[1].position, " ", vertices[1].color, " ", vertices[1].texCoord);
-			// LOG_INFO("vertices[2] = ", vertices[2].position, " ", vertices[2].color, " ", vertices[2].texCoord);
-			// LOG_INFO("vertices[3] = ", vertices[3].position, " ", vertices[3].color, " ", vertices[3].texCoord);
-			// LOG_INFO("model: ", scaleMatrixCoords(states.transform.getMatrix()));
-			// LOG_INFO("view: ", scaleMatrixCoords(camera->getViewMatrix()));
-			// LOG_INFO("projection", camera->getProjectionMatrix());
-
-			// Model, view. projection matrixes
-			shaderProgram->setUniform("model",			scaleMatrixCoords(states.transform.getMatrix()));
-			shaderProgram->setUniform("view",			scaleMatrixCoords(camera->getViewMatrix()));
-			shaderProgram->setUniform("projection", 	camera->getProjectionMatrix());
-			shaderProgram->setUniform("positionFactor", this->positionFactor);
-
-			if (states.texture) { // @todo ? Może dodać `Lightable`, a nie oświetlać tylko oteksturowane...
-				shaderProgram->setUniform("hasTexture", true);
-				shaderProgram->setUniform("isObject", true);
-
-				// Material
-				{
-					// Diffuse
-					glActiveTexture(GL_TEXTURE0);
-					states.texture->bind();
-					shaderProgram->setUniform("material.diffuseTexture", 0);
-					shaderProgram->setUniform("texture", 0);
-
-					// Specular // @todo . specular
-					//aderProgram->setUniform("material.specularTexture", ???.texture->getID());
-					//aderProgram->setUniform("material.shininess", ???.shininess);
-				}
-
-				// Lighting
-				shaderProgram->setUniform("cameraPosition", camera->getPosition());
-				shaderProgram->setUniform("basicAmbient", glm::vec3{0.1f, 0.1f, 0.1f});
-				applyLightPoints(shaderProgram);
+		// Batching textured triangles
+		if (this->batching) {
+			const PrimitiveType type = vertices.getPrimitiveType();
+			if (states.texture && (type == Triangles || type == TriangleFan)) {
+				this->_appendToBatch(vertices, states, shaderProgram);
+				return;
+			}
+			this->flushBatch();
+		}
+
+		vertices.update();
+
+		// World bounds, needed only for lighting
+		const glm::mat4& model = states.transform.getMatrix();
+		unsigned int lights[maxLightPointsPerObjectLimit];
+		std::size_t lightsCount = 0;
+		if (states.texture) {
+			glm::vec3 boundsMin;
+			glm::vec3 boundsMax;
+			const glm::vec4 bounds = vertices.getBounds();
+			boundsMin = boundsMax = glm::vec3(model * glm::vec4(bounds.x, bounds.y, 0.f, 1.f));
+			for (const glm::vec2& corner : {glm::vec2{bounds.x + bounds.z, bounds.y}, glm::vec2{bounds.x, bounds.y + bounds.w}, glm::vec2{bounds.x + bounds.z, bounds.y + bounds.w}}) {
+				const glm::vec3 point = glm::vec3(model * glm::vec4(corner, 0.f, 1.f));
+				boundsMin = glm::min(boundsMin, point);
+				boundsMax = glm::max(boundsMax, point);
 			}
+			lightsCount = this->_selectObjectLights(shaderProgram, boundsMin, boundsMax, lights);
 		}
 
+		// Shader configuration
+		glUseProgram(shaderProgram->getNativeHandle());
+		this->_applyStates(shaderProgram, model, states.texture, lights, lightsCount);
+
 		// Pass the vertices
 		vertices.bind();
-		glDrawArrays(vertices.getPrimitiveType(), 0, vertices.getSize());
+		if (vertices.isIndexed()) {
+			glDrawElements(vertices.getPrimitiveType(), static_cast<GLsizei>(vertices.getIndicesCount()), GL_UNSIGNED_INT, nullptr);
+		}
+		else {
+			glDrawArrays(vertices.getPrimitiveType(), 0, vertices.getSize());
+		}
 		vertices.unbind();
+		this->statistics.drawCalls++;
 
 		// Unbind testures if any
 		if (states.texture) {
@@ -232,6 +295,7 @@ void RenderTarget::draw(const VertexArray& vertices)
 // "Simple draw"
 void RenderTarget::simpleDraw(const VertexArray& vertices, RenderStates states)
 {
+    this->flushBatch();
     if (vertices.getSize() > 0 && this->_setActive()) {
 		vertices.update();
 
@@ -252,8 +316,14 @@ void RenderTarget::simpleDraw(const VertexArray& vertices, RenderStates states)
 
         // Pass the vertices
 		vertices.bind();
-        glDrawArrays(vertices.getPrimitiveType(), 0, vertices.getSize());
+        if (vertices.isIndexed()) {
+            glDrawElements(vertices.getPrimitiveType(), static_cast<GLsizei>(vertices.getIndicesCount()), GL_UNSIGNED_INT, nullptr);
+        }
+        else {
+            glDrawArrays(vertices.getPrimitiveType(), 0, vertices.getSize());
+        }
         vertices.unbind();
+        this->statistics.drawCalls++;
 
 		// Unbind testures if any
         if (states.texture) {
@@ -265,6 +335,273 @@ void RenderTarget::simpleDraw(const VertexArray& vertices) {
     this->simpleDraw(vertices, this->defaultStates);
 }
 
+// Batching
+void RenderTarget::beginBatch()
+{
+	if (!this->batchingEnabled || this->batching) {
+		return;
+	}
+
+	if (!this->batchVAO) {
+		glGenVertexArrays(1, &this->batchVAO);
+		glGenBuffers(1, &this->batchVBO);
+		glGenBuffers(1, &this->batchEBO);
+
+		glBindVertexArray(this->batchVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, this->batchVBO);
+		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, this->batchEBO);
+
+		glEnableVertexAttribArray(0);
+		glVertexAttribPointer(0, decltype(Vertex::position)::length(), GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, position)));
+		glEnableVertexAttribArray(1);
+		glVertexAttribPointer(1, decltype(Vertex::color)::length(), GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, color)));
+		glEnableVertexAttribArray(2);
+		glVertexAttribPointer(2, decltype(Vertex::texCoord)::length(), GL_FLOAT, GL_FALSE, sizeof(Vertex), reinterpret_cast<const void*>(offsetof(Vertex, texCoord)));
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+	}
+
+	this->batching = true;
+}
+void RenderTarget::endBatch()
+{
+	this->flushBatch();
+	this->batching = false;
+}
+void RenderTarget::flushBatch()
+{
+	if (this->batchVertices.empty()) {
+		return;
+	}
+	PROFILE_FUNCTION();
+
+	if (this->_setActive()) {
+		// Vertices are already in world space, so model matrix is identity
+		glUseProgram(this->batchShader->getNativeHandle());
+		this->_applyStates(this->batchShader, glm::mat4(1.f), this->batchTexture, this->batchLights, this->batchLightsCount);
+
+		// Upload to persistent buffers, growing or orphaning their storage
+		const std::size_t count = this->batchVertices.size();
+		const std::size_t indicesCount = this->batchIndices.size();
+		glBindVertexArray(this->batchVAO);
+		glBindBuffer(GL_ARRAY_BUFFER, this->batchVBO);
+		if (count > this->batchCapacity) {
+			this->batchCapacity = count + count / 2;
+		}
+		glBufferData(GL_ARRAY_BUFFER, this->batchCapacity * sizeof(Vertex), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ARRAY_BUFFER, 0, count * sizeof(Vertex), this->batchVertices.data());
+
+		// Element buffer is bound by vertex array object
+		if (indicesCount > this->batchIndicesCapacity) {
+			this->batchIndicesCapacity = indicesCount + indicesCount / 2;
+		}
+		glBufferData(GL_ELEMENT_ARRAY_BUFFER, this->batchIndicesCapacity * sizeof(GLuint), nullptr, GL_STREAM_DRAW);
+		glBufferSubData(GL_ELEMENT_ARRAY_BUFFER, 0, indicesCount * sizeof(GLuint), this->batchIndices.data());
+
+		glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indicesCount), GL_UNSIGNED_INT, nullptr);
+
+		glBindVertexArray(0);
+		glBindBuffer(GL_ARRAY_BUFFER, 0);
+		this->batchTexture->unbind();
+
+		this->statistics.drawCalls++;
+		this->statistics.batches++;
+		this->statistics.batchedVertices += count;
+		this->statistics.batchedIndices += indicesCount;
+	}
+
+	this->batchVertices.clear();
+	this->batchIndices.clear();
+	this->batchTexture = nullptr;
+	this->batchShader = nullptr;
+}
+
+void RenderTarget::_appendToBatch(const VertexArray& vertices, const RenderStates& states, ShaderProgram* shaderProgram)
+{
+	if (this->batchTexture != states.texture || this->batchShader != shaderProgram) {
+		this->flushBatch();
+		this->batchTexture = states.texture;
+		this->batchShader = shaderProgram;
+	}
+
+	const Vertex* data = vertices.getData();
+	const std::size_t size = vertices.getSize();
+	const GLuint* indices = vertices.isIndexed() ? vertices.getIndices().data() : nullptr;
+	const std::size_t count = vertices.isIndexed() ? vertices.getIndicesCount() : size;
+	if (count < 3) {
+		return;
+	}
+
+	// Same space as `model * (position * positionFactor)` in the shader, since model translation is scaled too
+	const glm::mat4& model = states.transform.getMatrix();
+	GLuint base = static_cast<GLuint>(this->batchVertices.size());
+	glm::vec3 boundsMin {std::numeric_limits<float>::max()};
+	glm::vec3 boundsMax {std::numeric_limits<float>::lowest()};
+	for (std::size_t i = 0; i < size; ++i) {
+		Vertex& transformed = this->batchVertices.emplace_back(data[i]);
+		transformed.position = glm::vec3(model * glm::vec4(data[i].position, 1.f));
+		boundsMin = glm::min(boundsMin, transformed.position);
+		boundsMax = glm::max(boundsMax, transformed.position);
+	}
+
+	// Lights are selected per object, so batch is broken where they change
+	unsigned int lights[maxLightPointsPerObjectLimit];
+	const std::size_t lightsCount = this->_selectObjectLights(shaderProgram, boundsMin, boundsMax, lights);
+	if (base > 0 && !std::equal(lights, lights + lightsCount, this->batchLights, this->batchLights + this->batchLightsCount)) {
+		// Only previous objects are flushed, just appended vertices start next batch
+		this->batchSplitVertices.assign(this->batchVertices.begin() + base, this->batchVertices.end());
+		this->batchVertices.resize(base);
+		this->flushBatch();
+		this->batchTexture = states.texture;
+		this->batchShader = shaderProgram;
+		std::swap(this->batchVertices, this->batchSplitVertices);
+		base = 0;
+	}
+	std::copy(lights, lights + lightsCount, this->batchLights);
+	this->batchLightsCount = lightsCount;
+
+	// Vertices are stored once, triangles refer to them by indices
+	auto index = [indices, base] (std::size_t i) {
+		return base + (indices ? indices[i] : static_cast<GLuint>(i));
+	};
+	if (vertices.getPrimitiveType() == TriangleFan) {
+		for (std::size_t i = 1; i + 1 < count; ++i) {
+			this->batchIndices.push_back(index(0));
+			this->batchIndices.push_back(index(i));
+			this->batchIndices.push_back(index(i + 1));
+		}
+	}
+	else {
+		for (std::size_t i = 0; i < count - count % 3; ++i) {
+			this->batchIndices.push_back(index(i));
+		}
+	}
+
+	this->statistics.batchedDraws++;
+}
+
+const RenderTarget::ShaderUniforms& RenderTarget::_getShaderUniforms(ShaderProgram* shaderProgram)
+{
+	ShaderUniforms& uniforms = this->shaderUniforms;
+
+	if (uniforms.program != shaderProgram || uniforms.revision != shaderProgram->getRevision()) {
+		uniforms.program = shaderProgram;
+		uniforms.revision = shaderProgram->getRevision();
+
+		uniforms.model                  = shaderProgram->getUniformHandle("model");
+		uniforms.view                   = shaderProgram->getUniformHandle("view");
+		uniforms.projection             = shaderProgram->getUniformHandle("projection");
+		uniforms.positionFactor         = shaderProgram->getUniformHandle("positionFactor");
+		uniforms.hasTexture             = shaderProgram->getUniformHandle("hasTexture");
+		uniforms.isObject               = shaderProgram->getUniformHandle("isObject");
+		uniforms.materialDiffuseTexture = shaderProgram->getUniformHandle("material.diffuseTexture");
+		uniforms.texture                = shaderProgram->getUniformHandle("texture");
+		uniforms.cameraPosition         = shaderProgram->getUniformHandle("cameraPosition");
+		uniforms.basicAmbient           = shaderProgram->getUniformHandle("basicAmbient");
+		uniforms.objectLightsLength     = shaderProgram->getUniformHandle("objectLightsLength");
+		uniforms.objectLights           = shaderProgram->getUniformHandle("objectLights");
+
+		// Lights are shared through uniform buffer
+		const GLuint blockIndex = glGetUniformBlockIndex(shaderProgram->getNativeHandle(), "PointLights");
+		if (blockIndex != GL_INVALID_INDEX) {
+			glUniformBlockBinding(shaderProgram->getNativeHandle(), blockIndex, lightPointsBindingPoint);
+		}
+	}
+
+	return uniforms;
+}
+
+void RenderTarget::_applyStates(ShaderProgram* shaderProgram, const glm::mat4& model, const Texture* texture, const unsigned int* lights, std::size_t lightsCount)
+{
+	const ShaderUniforms& uniforms = this->_getShaderUniforms(shaderProgram);
+
+	// Model, view. projection matrixes
+	shaderProgram->setUniform(uniforms.model,			scaleMatrixCoords(model));
+	shaderProgram->setUniform(uniforms.view,			scaleMatrixCoords(camera->getViewMatrix()));
+	shaderProgram->setUniform(uniforms.projection, 		camera->getProjectionMatrix());
+	shaderProgram->setUniform(uniforms.positionFactor,	this->positionFactor);
+
+	if (texture) { // @todo ? Może dodać `Lightable`, a nie oświetlać tylko oteksturowane...
+		shaderProgram->setUniform(uniforms.hasTexture, true);
+		shaderProgram->setUniform(uniforms.isObject, true);
+
+		// Material
+		{
+			// Diffuse
+			glActiveTexture(GL_TEXTURE0);
+			texture->bind();
+			if (texture->getID() != this->lastTextureID) {
+				this->lastTextureID = texture->getID();
+				this->statistics.textureChanges++;
+			}
+			shaderProgram->setUniform(uniforms.materialDiffuseTexture, 0);
+			shaderProgram->setUniform(uniforms.texture, 0);
+
+			// Specular // @todo . specular
+			//aderProgram->setUniform("material.specularTexture", ???.texture->getID());
+			//aderProgram->setUniform("material.shininess", ???.shininess);
+		}
+
+		// Lighting
+		shaderProgram->setUniform(uniforms.cameraPosition, camera->getPosition());
+		shaderProgram->setUniform(uniforms.basicAmbient, glm::vec3{0.1f, 0.1f, 0.1f});
+		applyLightPoints();
+		_applyObjectLights(shaderProgram, lights, lightsCount);
+	}
+}
+
+std::size_t RenderTarget::_selectObjectLights(ShaderProgram* shaderProgram, const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int* lights)
+{
+	const ShaderUniforms& uniforms = this->_getShaderUniforms(shaderProgram);
+	if (!uniforms.objectLights.isValid()) {
+		return 0;
+	}
+
+	// Spheres are rebuilt with uploaded lights
+	if (this->lightPointsDirty) {
+		applyLightPoints();
+	}
+
+	// Lights which sphere overlaps bounds, ordered by distance relative to radius
+	auto& candidates = this->objectLightsCandidates;
+	candidates.clear();
+	for (unsigned int i = 0; i < this->lightPointsSpheres.size(); i++) {
+		const glm::vec4& sphere = this->lightPointsSpheres[i];
+		const glm::vec3 center = glm::vec3(sphere);
+		const float distance = glm::distance(glm::clamp(center, boundsMin, boundsMax), center);
+		if (distance <= sphere.w) {
+			candidates.emplace_back(sphere.w > 0.f ? distance / sphere.w : 0.f, i);
+		}
+	}
+
+	const std::size_t count = std::min(candidates.size(), this->maxLightPointsPerObject);
+	if (candidates.size() > count) {
+		std::partial_sort(candidates.begin(), candidates.begin() + count, candidates.end());
+	}
+
+	// Ordered by index, so objects lit by same lights have equal sets
+	for (std::size_t i = 0; i < count; i++) {
+		lights[i] = candidates[i].second;
+	}
+	std::sort(lights, lights + count);
+	return count;
+}
+
+void RenderTarget::_applyObjectLights(ShaderProgram* shaderProgram, const unsigned int* lights, std::size_t lightsCount)
+{
+	const ShaderUniforms& uniforms = this->_getShaderUniforms(shaderProgram);
+	if (!uniforms.objectLights.isValid()) {
+		return;
+	}
+
+	if (lightsCount > 0) {
+		shaderProgram->setUniform(uniforms.objectLights, lights, lightsCount);
+	}
+	shaderProgram->setUniform(uniforms.objectLightsLength, static_cast<unsigned int>(lightsCount));
+	this->statistics.appliedLights += lightsCount;
+}
+
 // Interaction
 Linear RenderTarget::getLinearByScreenPosition(glm::vec2 screenPosition) const
 {
@@ -308,35 +645,65 @@ Linear RenderTarget::getLinearByScreenPosition(glm::vec2 screenPosition) const
 // Light points
 void RenderTarget::resetLightPoints()
 {
+	this->flushBatch();
 	this->lightPoints.clear();
+	this->lightPointsDirty = true;
 }
 void RenderTarget::registerLightPoint(LightPoint* lightPoint)
 {
+	this->flushBatch();
 	this->lightPoints.push_back(lightPoint);
+	this->lightPointsDirty = true;
 }
-void RenderTarget::applyLightPoints(ShaderProgram* shaderProgram)
-{
-	unsigned int i = 0;
-	for (const LightPoint* lightPoint : this->lightPoints) {
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].position", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->getPosition() * this->positionFactor);
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].color", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->getColor());
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].attenuation.constant", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->attenuation.constant);
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].attenuation.linear", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->attenuation.linear);
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].attenuation.quadratic", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->attenuation.quadratic);
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].ambientFactor", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->getAmbientFactor());
-		std::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].diffuseFactor", i);
-		shaderProgram->setUniform(this->uniformNameBuffer, lightPoint->getDiffuseFactor());
-		//d::snprintf(this->uniformNameBuffer, 64, "pointLights[%u].specularFactor", i); // @todo . specular
-		//aderProgram->setUniform(this->uniformNameBuffer, lightPoint->getSpecularFactor());
-		i++;
-	}
-	shaderProgram->setUniform("pointLightsLength", i);
+void RenderTarget::applyLightPoints()
+{
+	if (!this->lightPointsUBO) {
+		glGenBuffers(1, &this->lightPointsUBO);
+		glBindBuffer(GL_UNIFORM_BUFFER, this->lightPointsUBO);
+		glBufferData(GL_UNIFORM_BUFFER, sizeof(PointLightsBlock), nullptr, GL_DYNAMIC_DRAW);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+		this->lightPointsDirty = true;
+	}
+
+	if (this->lightPointsDirty) {
+		PointLightsBlock& block = this->lightPointsBlock;
+
+		// Warned only when limit is crossed, not each frame it stays crossed
+		const bool overflow = this->lightPoints.size() > maxLightPoints;
+		if (overflow && !this->lightPointsOverflow) {
+			LOG_WARNING("Too many light points registered, only first ", maxLightPoints, " are used");
+		}
+		this->lightPointsOverflow = overflow;
+
+		std::size_t count = 0;
+		this->lightPointsSpheres.clear();
+		for (const LightPoint* lightPoint : this->lightPoints) {
+			if (count >= maxLightPoints) {
+				break;
+			}
+			PointLightBlock& light = block.lights[count++];
+			light.position		= glm::vec4(lightPoint->getPosition() * this->positionFactor, 1.f);
+			light.color			= glm::vec4(lightPoint->getColor(), 1.f);
+			light.attenuation	= glm::vec4(lightPoint->attenuation.constant, lightPoint->attenuation.linear, lightPoint->attenuation.quadratic, 0.f);
+			light.ambientFactor	= glm::vec4(lightPoint->getAmbientFactor(), 0.f);
+			light.diffuseFactor	= glm::vec4(lightPoint->getDiffuseFactor(), 0.f);
+			// @todo . specular
+
+			// Attenuation is calculated in scaled coords, like in the shader
+			const float radius = lightPoint->getAttenuationRadius() / this->positionFactor;
+			this->lightPointsSpheres.emplace_back(lightPoint->getPosition(), radius);
+		}
+		block.length.x = static_cast<unsigned int>(count);
+
+		// Upload only used part of the block
+		glBindBuffer(GL_UNIFORM_BUFFER, this->lightPointsUBO);
+		glBufferSubData(GL_UNIFORM_BUFFER, 0, offsetof(PointLightsBlock, lights) + count * sizeof(PointLightBlock), &block);
+		glBindBuffer(GL_UNIFORM_BUFFER, 0);
+
+		this->lightPointsDirty = false;
+	}
+
+	glBindBufferBase(GL_UNIFORM_BUFFER, lightPointsBindingPoint, this->lightPointsUBO);
 }
 
 }
@@ -8,17 +8,22 @@
 #include <vector>
 
 #include <glm/vec2.hpp>
+#include <glm/vec4.hpp>
 #include <glm/mat4x4.hpp>
 
-#include <glad/glad.h> // GLbitfield
+#include <glad/glad.h> // GLbitfield, GLuint
 
 namespace sf {
 	class Color;
 }
 #include "RenderStates.hpp"
 #include "Camera.hpp"
+#include "Frustum.hpp"
+#include "Vertex.hpp"
+#include "UniformHandle.hpp"
 namespace sf3d {
 	class VertexArray;
+	class Texture;
 	class Drawable;
 	class LightPoint;
 	class Linear;
@@ -28,6 +33,31 @@ namespace sf3d {
 namespace sf3d
 {
 
+/// Counters of render operations, used to measure draw call overhead
+struct RenderStatistics
+{
+	/// Number of `glDraw*` calls issued
+	std::size_t drawCalls {0};
+
+	/// Number of flushed batches (each is also counted as a draw call)
+	std::size_t batches {0};
+
+	/// Number of vertex arrays merged into batches
+	std::size_t batchedDraws {0};
+
+	/// Number of vertices submitted through batches
+	std::size_t batchedVertices {0};
+
+	/// Number of indices submitted through batches, vertices shared by triangles are submitted once
+	std::size_t batchedIndices {0};
+
+	/// Number of light points passed to shader, summed over lit draw calls
+	std::size_t appliedLights {0};
+
+	/// Number of draw calls which use different texture than previous one
+	std::size_t textureChanges {0};
+};
+
 /// Performs render operations
 class RenderTarget
 {
@@ -43,11 +73,85 @@ protected:
 public:
 	float positionFactor;
 
+	/// Capacity of point lights uniform block, must match `MAX_LIGHTS` in shaders
+	static constexpr std::size_t maxLightPoints = 128;
+
+	/// Uniform buffer binding point used by `PointLights` block
+	static constexpr GLuint lightPointsBindingPoint = 0;
+
+	/// Capacity of lights list for single object, must match `MAX_OBJECT_LIGHTS` in shaders
+	static constexpr std::size_t maxLightPointsPerObjectLimit = 16;
+
 protected:
 	std::vector<LightPoint*> lightPoints;
 
+	RenderStatistics statistics;
+	GLuint lastTextureID {0};
+
 private:
-	char uniformNameBuffer[64];
+	/// Point light in std140 layout of `PointLights` uniform block
+	struct PointLightBlock
+	{
+		glm::vec4 position;
+		glm::vec4 color;
+		glm::vec4 attenuation;
+		glm::vec4 ambientFactor;
+		glm::vec4 diffuseFactor;
+	};
+
+	/// `PointLights` uniform block in std140 layout
+	struct PointLightsBlock
+	{
+		glm::uvec4 length;
+		PointLightBlock lights[maxLightPoints];
+	};
+
+	// Light points uniform buffer, uploaded once after lights change from block kept for it
+	GLuint lightPointsUBO {0};
+	PointLightsBlock lightPointsBlock;
+	bool lightPointsDirty {true};
+	bool lightPointsOverflow {false};
+
+	// Light culling, spheres are { position, radius } in world space
+	std::size_t maxLightPointsPerObject {8};
+	std::vector<glm::vec4> lightPointsSpheres;
+	std::vector<std::pair<float, unsigned int>> objectLightsCandidates;
+
+	// Uniform handles resolved for last used shader program
+	struct ShaderUniforms
+	{
+		const ShaderProgram* program {nullptr};
+		std::size_t revision {0};
+
+		UniformHandle model;
+		UniformHandle view;
+		UniformHandle projection;
+		UniformHandle positionFactor;
+		UniformHandle hasTexture;
+		UniformHandle isObject;
+		UniformHandle materialDiffuseTexture;
+		UniformHandle texture;
+		UniformHandle cameraPosition;
+		UniformHandle basicAmbient;
+		UniformHandle objectLightsLength;
+		UniformHandle objectLights;
+	} shaderUniforms;
+
+	// Batching
+	bool batchingEnabled {true};
+	bool batching {false};
+	std::vector<Vertex> batchVertices;
+	std::vector<GLuint> batchIndices;
+	const Texture* batchTexture {nullptr};
+	ShaderProgram* batchShader {nullptr};
+	GLuint batchVAO {0};
+	GLuint batchVBO {0};
+	GLuint batchEBO {0};
+	std::size_t batchCapacity {0};
+	std::size_t batchIndicesCapacity {0};
+	std::vector<Vertex> batchSplitVertices;
+	unsigned int batchLights[maxLightPointsPerObjectLimit];
+	std::size_t batchLightsCount {0};
 
 
 
@@ -64,6 +168,24 @@ public:
 	const Camera* getCamera() const;
 	void setCamera(Camera* camera);
 	void setCamera(Camera& camera);
+
+	/// View volume of current camera in world coordinates, used to skip invisible objects
+	Frustum getViewFrustum() const;
+
+	/// Whether `beginBatch` should start collecting textured geometry
+	bool isBatchingEnabled() const;
+	void setBatchingEnabled(bool state);
+
+	/// Whether geometry is being collected now
+	bool isBatching() const;
+
+	/// Maximal number of lights shading single drawn object, nearest ones are choosen
+	std::size_t getMaxLightPointsPerObject() const;
+	void setMaxLightPointsPerObject(std::size_t count);
+
+	/// Counters collected since last `resetStatistics` call
+	const RenderStatistics& getStatistics() const;
+	void resetStatistics();
 	
 
 
@@ -83,6 +205,21 @@ protected:
 
 	virtual bool _setActive(bool state = true) = 0;
 
+	/// Resolves uniform handles if shader program changed since last draw
+	const ShaderUniforms& _getShaderUniforms(ShaderProgram* shaderProgram);
+
+	/// Uploads matrices, material and lighting uniforms for single draw, lights are indices selected by `_selectObjectLights`
+	void _applyStates(ShaderProgram* shaderProgram, const glm::mat4& model, const Texture* texture, const unsigned int* lights, std::size_t lightsCount);
+
+	/// Selects lights which radius reach object world bounds, nearest first. Returns their count, none if shader does not use them
+	std::size_t _selectObjectLights(ShaderProgram* shaderProgram, const glm::vec3& boundsMin, const glm::vec3& boundsMax, unsigned int* lights);
+
+	/// Passes indices of selected lights to shader
+	void _applyObjectLights(ShaderProgram* shaderProgram, const unsigned int* lights, std::size_t lightsCount);
+
+	/// Appends vertices transformed on CPU to current batch
+	void _appendToBatch(const VertexArray& vertices, const RenderStates& states, ShaderProgram* shaderProgram);
+
 public:
 	/// Helper function to scale matrix coords propertly
 	glm::mat4 scaleMatrixCoords(glm::mat4 matrix);
@@ -102,6 +239,14 @@ public:
     // "Simple draw" 
     void simpleDraw(const VertexArray& vertices, RenderStates states); 
     void simpleDraw(const VertexArray& vertices); 
+
+	// Batching
+	/// Starts collecting textured triangles sharing texture and shader into one vertex buffer
+	void beginBatch();
+	/// Draws collected geometry and stops batching
+	void endBatch();
+	/// Draws collected geometry as single draw call
+	void flushBatch();
 	
 	// Interaction
 	Linear getLinearByScreenPosition(glm::vec2 pos) const;
@@ -109,7 +254,8 @@ public:
 	// Light points
 	void resetLightPoints();
 	void registerLightPoint(LightPoint* lightPoint);
-	void applyLightPoints(ShaderProgram* shaderProgram);
+	/// Uploads registered light points to uniform buffer if they changed
+	void applyLightPoints();
 };
 
 }
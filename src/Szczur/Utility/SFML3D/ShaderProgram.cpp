@@ -1,7 +1,9 @@
 #include "ShaderProgram.hpp"
 
+#include <cstring>
 #include <fstream>
 #include <stdexcept>
+#include <string>
 
 #include <nlohmann/json.hpp>
 
@@ -10,6 +12,8 @@
 #ifdef EDITOR
 #	include <imgui.h>
 #	include <imgui-SFML.h>
+#	include "Szczur/Utility/FileWatcher.hpp"
+#	include "Szczur/Utility/Logger.hpp"
 #endif // EDITOR
 
 #include "Szczur/Utility/Convert/Hash.hpp"
@@ -92,16 +96,15 @@ Overloaded(Ts&&...) -> Overloaded<Ts...>;
 namespace sf3d
 {
 
-///
+/// Makes program current for the scope, restoring previous one after
 class UniformBinder
 {
 public:
 
 	///
-	UniformBinder(GLuint program, const char* name)
+	UniformBinder(GLuint program)
 		: _savedProgram { 0 }
 		, _program { program }
-		, _location { -1 }
 	{
 		if (_program)
 		{
@@ -114,8 +117,6 @@ public:
 			{
 				glUseProgram(_program);
 			}
-
-			_location = glGetUniformLocation(_program, name);
 		}
 	}
 
@@ -140,30 +141,49 @@ public:
 		}
 	}
 
-	///
-	GLint getLocation() const
-	{
-		return _location;
-	}
-
-	///
-	bool hasValidLocation() const
-	{
-		return _location != -1;
-	}
-
 private:
 
 	GLuint _savedProgram;
 	GLuint _program;
-	GLint _location;
 
 };
 
+///
+inline void uploadUniform(GLint location, bool value) { glUniform1i(location, value); }
+inline void uploadUniform(GLint location, const glm::bvec2& value) { glUniform2i(location, value.x, value.y); }
+inline void uploadUniform(GLint location, const glm::bvec3& value) { glUniform3i(location, value.x, value.y, value.z); }
+inline void uploadUniform(GLint location, const glm::bvec4& value) { glUniform4i(location, value.x, value.y, value.z, value.w); }
+inline void uploadUniform(GLint location, int value) { glUniform1i(location, value); }
+inline void uploadUniform(GLint location, const glm::ivec2& value) { glUniform2i(location, value.x, value.y); }
+inline void uploadUniform(GLint location, const glm::ivec3& value) { glUniform3i(location, value.x, value.y, value.z); }
+inline void uploadUniform(GLint location, const glm::ivec4& value) { glUniform4i(location, value.x, value.y, value.z, value.w); }
+inline void uploadUniform(GLint location, unsigned int value) { glUniform1ui(location, value); }
+inline void uploadUniform(GLint location, const glm::uvec2& value) { glUniform2ui(location, value.x, value.y); }
+inline void uploadUniform(GLint location, const glm::uvec3& value) { glUniform3ui(location, value.x, value.y, value.z); }
+inline void uploadUniform(GLint location, const glm::uvec4& value) { glUniform4ui(location, value.x, value.y, value.z, value.w); }
+inline void uploadUniform(GLint location, float value) { glUniform1f(location, value); }
+inline void uploadUniform(GLint location, const glm::vec2& value) { glUniform2f(location, value.x, value.y); }
+inline void uploadUniform(GLint location, const glm::vec3& value) { glUniform3f(location, value.x, value.y, value.z); }
+inline void uploadUniform(GLint location, const glm::vec4& value) { glUniform4f(location, value.x, value.y, value.z, value.w); }
+inline void uploadUniform(GLint location, const glm::mat2x2& value, bool transpose) { glUniformMatrix2fv(location, 1, transpose, glm::value_ptr(value)); }
+inline void uploadUniform(GLint location, const glm::mat3x3& value, bool transpose) { glUniformMatrix3fv(location, 1, transpose, glm::value_ptr(value)); }
+inline void uploadUniform(GLint location, const glm::mat4x4& value, bool transpose) { glUniformMatrix4fv(location, 1, transpose, glm::value_ptr(value)); }
+
 ShaderProgram::ShaderProgram(ShaderProgram&& rhs) noexcept
 	: _program { rhs._program }
+	, _revision { rhs._revision }
+	, _uniformInfos { std::move(rhs._uniformInfos) }
+	, _uniformIndices { std::move(rhs._uniformIndices) }
 {
 	rhs._program = 0;
+
+	#ifdef EDITOR
+	{
+		auto sources = std::move(rhs._shaderSources);
+		rhs._unwatchShaders();
+		_watchShaders(std::move(sources));
+	}
+	#endif // EDITOR
 }
 
 ShaderProgram& ShaderProgram::operator = (ShaderProgram&& rhs) noexcept
@@ -173,7 +193,18 @@ ShaderProgram& ShaderProgram::operator = (ShaderProgram&& rhs) noexcept
 		_destroy();
 
 		_program = rhs._program;
+		_revision = rhs._revision;
+		_uniformInfos = std::move(rhs._uniformInfos);
+		_uniformIndices = std::move(rhs._uniformIndices);
 		rhs._program = 0;
+
+		#ifdef EDITOR
+		{
+			auto sources = std::move(rhs._shaderSources);
+			rhs._unwatchShaders();
+			_watchShaders(std::move(sources));
+		}
+		#endif // EDITOR
 	}
 
 	return *this;
@@ -181,14 +212,21 @@ ShaderProgram& ShaderProgram::operator = (ShaderProgram&& rhs) noexcept
 
 ShaderProgram::~ShaderProgram()
 {
+	#ifdef EDITOR
+	{
+		_unwatchShaders();
+	}
+	#endif // EDITOR
+
 	_destroy();
 }
 
-bool ShaderProgram::setUniform(const char* name, bool value)
+template <typename T, typename... Ts>
+bool ShaderProgram::_setUniform(const char* name, const T& value, Ts... args)
 {
-	UniformBinder binder{ _program, name };
+	const UniformHandle handle = getUniformHandle(name);
 
-	if (binder.hasValidLocation())
+	if (handle.isValid())
 	{
 		#ifdef EDITOR
 		{
@@ -196,372 +234,266 @@ bool ShaderProgram::setUniform(const char* name, bool value)
 		}
 		#endif // EDITOR
 
-		glUniform1i(binder.getLocation(), value);
+		UniformBinder binder{ _program };
 
-		return true;
+		return _setUniform(handle, value, args...);
 	}
 
 	return false;
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::bvec2& value)
+template <typename T, typename... Ts>
+bool ShaderProgram::_setUniform(UniformHandle handle, const T& value, Ts... args)
 {
-	UniformBinder binder{ _program, name };
+	static_assert(sizeof(T) <= sizeof(_UniformInfo::shadow), "Uniform value does not fit the shadow");
 
-	if (binder.hasValidLocation())
+	if (!handle.isValid() || static_cast<size_t>(handle.getIndex()) >= _uniformInfos.size())
 	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform2i(binder.getLocation(), value.x, value.y);
-
-		return true;
+		return false;
 	}
 
-	return false;
-}
+	_UniformInfo& info = _uniformInfos[handle.getIndex()];
 
-bool ShaderProgram::setUniform(const char* name, const glm::bvec3& value)
-{
-	UniformBinder binder{ _program, name };
+	// Transposed matrices are always uploaded and not shadowed, since stored value would differ
+	const bool transposed = (static_cast<bool>(args) || ... || false);
 
-	if (binder.hasValidLocation())
+	// Skip upload if the program already holds this value
+	if (!transposed && info.hasShadow && std::memcmp(info.shadow, &value, sizeof(T)) == 0)
 	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+		return true;
+	}
 
-		glUniform3i(binder.getLocation(), value.x, value.y, value.z);
+	uploadUniform(info.location, value, args...);
 
-		return true;
+	if (transposed)
+	{
+		info.hasShadow = false;
+	}
+	else
+	{
+		std::memcpy(info.shadow, &value, sizeof(T));
+		info.hasShadow = true;
 	}
 
-	return false;
+	return true;
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::bvec4& value)
+UniformHandle ShaderProgram::getUniformHandle(const char* name) const
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
+	if (auto it = _uniformIndices.find(rat::fnv1a_64(name)); it != _uniformIndices.end())
 	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform4i(binder.getLocation(), value.x, value.y, value.z, value.w);
-
-		return true;
+		return UniformHandle{ it->second };
 	}
 
-	return false;
+	return UniformHandle{};
 }
 
-bool ShaderProgram::setUniform(const char* name, int value)
+bool ShaderProgram::setUniform(const char* name, bool value)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(name, value);
+}
 
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+bool ShaderProgram::setUniform(const char* name, const glm::bvec2& value)
+{
+	return _setUniform(name, value);
+}
 
-		glUniform1i(binder.getLocation(), value);
+bool ShaderProgram::setUniform(const char* name, const glm::bvec3& value)
+{
+	return _setUniform(name, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(const char* name, const glm::bvec4& value)
+{
+	return _setUniform(name, value);
+}
 
-	return false;
+bool ShaderProgram::setUniform(const char* name, int value)
+{
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::ivec2& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform2i(binder.getLocation(), value.x, value.y);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::ivec3& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform3i(binder.getLocation(), value.x, value.y, value.z);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::ivec4& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform4i(binder.getLocation(), value.x, value.y, value.z, value.w);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, unsigned int value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform1ui(binder.getLocation(), value);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::uvec2& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform2ui(binder.getLocation(), value.x, value.y);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::uvec3& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform3ui(binder.getLocation(), value.x, value.y, value.z);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::uvec4& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform4ui(binder.getLocation(), value.x, value.y, value.z, value.w);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, float value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
-
-		glUniform1f(binder.getLocation(), value);
-
-		return true;
-	}
-
-	return false;
+	return _setUniform(name, value);
 }
 
 bool ShaderProgram::setUniform(const char* name, const glm::vec2& value)
 {
-	UniformBinder binder{ _program, name };
-
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+	return _setUniform(name, value);
+}
 
-		glUniform2f(binder.getLocation(), value.x, value.y);
+bool ShaderProgram::setUniform(const char* name, const glm::vec3& value)
+{
+	return _setUniform(name, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(const char* name, const glm::vec4& value)
+{
+	return _setUniform(name, value);
+}
 
-	return false;
+bool ShaderProgram::setUniform(const char* name, const glm::mat2x2& value, bool transpose)
+{
+	return _setUniform(name, value, transpose);
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::vec3& value)
+bool ShaderProgram::setUniform(const char* name, const glm::mat3x3& value, bool transpose)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(name, value, transpose);
+}
 
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+bool ShaderProgram::setUniform(const char* name, const glm::mat4x4& value, bool transpose)
+{
+	return _setUniform(name, value, transpose);
+}
 
-		glUniform3f(binder.getLocation(), value.x, value.y, value.z);
+bool ShaderProgram::setUniform(UniformHandle handle, bool value)
+{
+	return _setUniform(handle, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::bvec2& value)
+{
+	return _setUniform(handle, value);
+}
 
-	return false;
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::bvec3& value)
+{
+	return _setUniform(handle, value);
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::vec4& value)
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::bvec4& value)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(handle, value);
+}
 
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+bool ShaderProgram::setUniform(UniformHandle handle, int value)
+{
+	return _setUniform(handle, value);
+}
 
-		glUniform4f(binder.getLocation(), value.x, value.y, value.z, value.w);
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::ivec2& value)
+{
+	return _setUniform(handle, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::ivec3& value)
+{
+	return _setUniform(handle, value);
+}
 
-	return false;
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::ivec4& value)
+{
+	return _setUniform(handle, value);
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::mat2x2& value, bool transpose)
+bool ShaderProgram::setUniform(UniformHandle handle, unsigned int value)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(handle, value);
+}
 
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::uvec2& value)
+{
+	return _setUniform(handle, value);
+}
 
-		glUniformMatrix2fv(binder.getLocation(), 1, transpose, glm::value_ptr(value));
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::uvec3& value)
+{
+	return _setUniform(handle, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::uvec4& value)
+{
+	return _setUniform(handle, value);
+}
 
-	return false;
+bool ShaderProgram::setUniform(UniformHandle handle, float value)
+{
+	return _setUniform(handle, value);
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::mat3x3& value, bool transpose)
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::vec2& value)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(handle, value);
+}
 
-	if (binder.hasValidLocation())
-	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::vec3& value)
+{
+	return _setUniform(handle, value);
+}
 
-		glUniformMatrix3fv(binder.getLocation(), 1, transpose, glm::value_ptr(value));
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::vec4& value)
+{
+	return _setUniform(handle, value);
+}
 
-		return true;
-	}
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::mat2x2& value, bool transpose)
+{
+	return _setUniform(handle, value, transpose);
+}
 
-	return false;
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::mat3x3& value, bool transpose)
+{
+	return _setUniform(handle, value, transpose);
 }
 
-bool ShaderProgram::setUniform(const char* name, const glm::mat4x4& value, bool transpose)
+bool ShaderProgram::setUniform(UniformHandle handle, const glm::mat4x4& value, bool transpose)
 {
-	UniformBinder binder{ _program, name };
+	return _setUniform(handle, value, transpose);
+}
 
-	if (binder.hasValidLocation())
+bool ShaderProgram::setUniform(UniformHandle handle, const unsigned int* values, std::size_t count)
+{
+	if (!handle.isValid() || handle.getIndex() + count > _uniformInfos.size())
 	{
-		#ifdef EDITOR
-		{
-			_uniforms[name] = value;
-		}
-		#endif // EDITOR
+		return false;
+	}
 
-		glUniformMatrix4fv(binder.getLocation(), 1, transpose, glm::value_ptr(value));
+	glUniform1uiv(_uniformInfos[handle.getIndex()].location, static_cast<GLsizei>(count), values);
 
-		return true;
+	// Elements of array are registered one after another
+	for (std::size_t i = 0; i < count; ++i)
+	{
+		_uniformInfos[handle.getIndex() + i].hasShadow = false;
 	}
 
-	return false;
+	return true;
 }
 
 void ShaderProgram::loadConfig(const nlohmann::json& config)
@@ -695,6 +627,11 @@ ShaderProgram::NativeHandle_t ShaderProgram::getNativeHandle() const
 	return _program;
 }
 
+std::size_t ShaderProgram::getRevision() const
+{
+	return _revision;
+}
+
 #ifdef EDITOR
 
 ///
@@ -941,6 +878,90 @@ void ShaderProgram::_saveConfig(const char* path) const
 	std::ofstream{ path } << std::setw(4) << config;
 }
 
+void ShaderProgram::_watchShaders(ShaderSources_t sources)
+{
+	_unwatchShaders();
+
+	// Shaders loaded from memory cannot be reloaded
+	for (auto& [type, path] : sources)
+	{
+		if (path.empty()) return;
+	}
+
+	_shaderSources = std::move(sources);
+
+	for (auto& [type, path] : _shaderSources)
+	{
+		_shaderWatches.push_back(rat::FileWatcher::get().watch(path, [this](const std::string&) {
+			_reloadShaders();
+		}));
+	}
+}
+
+void ShaderProgram::_unwatchShaders()
+{
+	for (auto watch : _shaderWatches)
+	{
+		rat::FileWatcher::get().unwatch(watch);
+	}
+	_shaderWatches.clear();
+	_shaderSources.clear();
+}
+
+void ShaderProgram::_reloadShaders()
+{
+	std::vector<Shader> shaders;
+	try
+	{
+		for (auto& [type, path] : _shaderSources)
+		{
+			shaders.emplace_back(type, path);
+		}
+	}
+	catch (const std::exception& exc)
+	{
+		LOG_EXCEPTION(exc);
+		return;
+	}
+
+	// Linked aside, so failed edit leaves current program working
+	GLuint program = glCreateProgram();
+
+	for (auto& shader : shaders)
+	{
+		glAttachShader(program, shader.getNativeHandle());
+	}
+
+	glLinkProgram(program);
+
+	for (auto& shader : shaders)
+	{
+		glDetachShader(program, shader.getNativeHandle());
+	}
+
+	GLint success;
+	glGetProgramiv(program, GL_LINK_STATUS, &success);
+
+	if (success != GL_TRUE)
+	{
+		GLchar infoLog[512];
+		glGetProgramInfoLog(program, sizeof(infoLog), nullptr, infoLog);
+
+		glDeleteProgram(program);
+
+		LOG_WARNING("Unable to relink shader program ", _program, ", keeping previous one:\n", infoLog);
+		return;
+	}
+
+	_destroy();
+
+	_program = program;
+
+	_finishLinking();
+
+	LOG_INFO("Shader program ", _program, " reloaded");
+}
+
 #endif // EDITOR
 
 void ShaderProgram::_destroy()
@@ -949,6 +970,9 @@ void ShaderProgram::_destroy()
 	{
 		glDeleteProgram(_program);
 
+		_uniformInfos.clear();
+		_uniformIndices.clear();
+
 		#ifdef EDITOR
         {
             _uniforms.clear();
@@ -975,12 +999,19 @@ void ShaderProgram::_finishLinking()
 		throw std::runtime_error(std::string("Unable to link shader program:\n") + infoLog);
 	}
 
-	#ifdef EDITOR
+	++_revision;
+
+	// Cache locations of active uniforms
 	{
 		GLint count;
 		GLint size;
 		GLenum type;
-		GLchar name[64];
+		GLchar name[128];
+
+		auto registerUniform = [this] (const std::string& name, GLint location) {
+			_uniformIndices[rat::fnv1a_64(name.data())] = static_cast<int>(_uniformInfos.size());
+			_uniformInfos.push_back({ location, false, {} });
+		};
 
 		glGetProgramiv(_program, GL_ACTIVE_UNIFORMS, &count);
 
@@ -988,145 +1019,173 @@ void ShaderProgram::_finishLinking()
 		{
 			glGetActiveUniform(_program, i, sizeof(name), nullptr, &size, &type, name);
 
-			switch (type)
+			const GLint location = glGetUniformLocation(_program, name);
+
+			// Members of uniform blocks have no location
+			if (location == -1)
 			{
-				case GL_BOOL:
-				{
-					int value;
-					glGetUniformiv(_program, i, &value);
-					_uniforms.emplace(name, static_cast<bool>(value));
-				}
-				break;
-				case GL_BOOL_VEC2:
-				{
-					glm::ivec2 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, glm::bvec2{ value });
-				}
-				break;
-				case GL_BOOL_VEC3:
-				{
-					glm::ivec3 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, glm::bvec3{ value });
-				}
-				break;
-				case GL_BOOL_VEC4:
-				{
-					glm::ivec4 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, glm::bvec4{ value });
-				}
-				break;
-				case GL_INT:
-				{
-					int value;
-					glGetUniformiv(_program, i, &value);
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_INT_VEC2:
-				{
-					glm::ivec2 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_INT_VEC3:
-				{
-					glm::ivec3 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_INT_VEC4:
-				{
-					glm::ivec4 value;
-					glGetUniformiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_UNSIGNED_INT:
-				{
-					unsigned value;
-					glGetUniformuiv(_program, i, &value);
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_UNSIGNED_INT_VEC2:
-				{
-					glm::uvec2 value;
-					glGetUniformuiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_UNSIGNED_INT_VEC3:
-				{
-					glm::uvec3 value;
-					glGetUniformuiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_UNSIGNED_INT_VEC4:
-				{
-					glm::uvec4 value;
-					glGetUniformuiv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT:
-				{
-					float value;
-					glGetUniformfv(_program, i, &value);
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT_VEC2:
-				{
-					glm::vec2 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT_VEC3:
-				{
-					glm::vec3 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT_VEC4:
-				{
-					glm::vec4 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT_MAT2:
-				{
-					glm::mat2x2 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
-				}
-				break;
-				case GL_FLOAT_MAT3:
+				continue;
+			}
+
+			registerUniform(name, location);
+
+			// Arrays of basic types are reported once, as `name[0]`
+			if (size > 1)
+			{
+				const std::string base = std::string{ name }.substr(0, std::string{ name }.rfind('['));
+
+				_uniformIndices[rat::fnv1a_64(base.data())] = static_cast<int>(_uniformInfos.size()) - 1;
+
+				for (GLint e = 1; e < size; ++e)
 				{
-					glm::mat3x3 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
+					const std::string element = base + '[' + std::to_string(e) + ']';
+
+					registerUniform(element, glGetUniformLocation(_program, element.data()));
 				}
-				break;
-				case GL_FLOAT_MAT4:
+			}
+
+			#ifdef EDITOR
+			{
+				switch (type)
 				{
-					glm::mat4x4 value;
-					glGetUniformfv(_program, i, glm::value_ptr(value));
-					_uniforms.emplace(name, value);
+					case GL_BOOL:
+					{
+						int value;
+						glGetUniformiv(_program, location, &value);
+						_uniforms.emplace(name, static_cast<bool>(value));
+					}
+					break;
+					case GL_BOOL_VEC2:
+					{
+						glm::ivec2 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, glm::bvec2{ value });
+					}
+					break;
+					case GL_BOOL_VEC3:
+					{
+						glm::ivec3 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, glm::bvec3{ value });
+					}
+					break;
+					case GL_BOOL_VEC4:
+					{
+						glm::ivec4 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, glm::bvec4{ value });
+					}
+					break;
+					case GL_INT:
+					{
+						int value;
+						glGetUniformiv(_program, location, &value);
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_INT_VEC2:
+					{
+						glm::ivec2 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_INT_VEC3:
+					{
+						glm::ivec3 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_INT_VEC4:
+					{
+						glm::ivec4 value;
+						glGetUniformiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_UNSIGNED_INT:
+					{
+						unsigned value;
+						glGetUniformuiv(_program, location, &value);
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_UNSIGNED_INT_VEC2:
+					{
+						glm::uvec2 value;
+						glGetUniformuiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_UNSIGNED_INT_VEC3:
+					{
+						glm::uvec3 value;
+						glGetUniformuiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_UNSIGNED_INT_VEC4:
+					{
+						glm::uvec4 value;
+						glGetUniformuiv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT:
+					{
+						float value;
+						glGetUniformfv(_program, location, &value);
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_VEC2:
+					{
+						glm::vec2 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_VEC3:
+					{
+						glm::vec3 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_VEC4:
+					{
+						glm::vec4 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_MAT2:
+					{
+						glm::mat2x2 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_MAT3:
+					{
+						glm::mat3x3 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
+					case GL_FLOAT_MAT4:
+					{
+						glm::mat4x4 value;
+						glGetUniformfv(_program, location, glm::value_ptr(value));
+						_uniforms.emplace(name, value);
+					}
+					break;
 				}
-				break;
 			}
+			#endif // EDITOR
 		}
 	}
-	#endif // EDITOR
 }
 
 }
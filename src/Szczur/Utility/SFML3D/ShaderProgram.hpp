@@ -12,13 +12,21 @@
 
 #include <nlohmann/json_fwd.hpp>
 
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
 #ifdef EDITOR
 #   include <map>
 #   include <string>
+#   include <utility>
 #   include <variant>
 #endif // EDITOR
 
+#include "Szczur/Utility/Convert/Hash.hpp"
+
 #include "Shader.hpp"
+#include "UniformHandle.hpp"
 
 namespace sf3d
 {
@@ -108,6 +116,69 @@ public:
 	///
 	bool setUniform(const char* name, const glm::mat4x4& value, bool transpose = GL_FALSE);
 
+	/// Returns handle of active uniform, invalid if there is no such uniform
+	UniformHandle getUniformHandle(const char* name) const;
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, bool value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::bvec2& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::bvec3& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::bvec4& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, int value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::ivec2& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::ivec3& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::ivec4& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, unsigned int value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::uvec2& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::uvec3& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::uvec4& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, float value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::vec2& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::vec3& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::vec4& value);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::mat2x2& value, bool transpose = GL_FALSE);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::mat3x3& value, bool transpose = GL_FALSE);
+
+	/// Program must be in use
+	bool setUniform(UniformHandle handle, const glm::mat4x4& value, bool transpose = GL_FALSE);
+
+	/// Uploads array of uints starting at given element, program must be in use
+	bool setUniform(UniformHandle handle, const unsigned int* values, std::size_t count);
+
 	///
 	void loadConfig(const nlohmann::json& config);
 
@@ -120,6 +191,9 @@ public:
 	///
 	NativeHandle_t getNativeHandle() const;
 
+	/// Changes after every relinking, so cached handles can be validated
+	std::size_t getRevision() const;
+
 	#ifdef EDITOR
 
 	using UniKey_t     = std::string;
@@ -135,6 +209,20 @@ public:
 	///
 	void _saveConfig(const char* path) const;
 
+	using ShaderSources_t = std::vector<std::pair<Shader::ShaderType, std::string>>;
+
+	/// Watches shader files, program is relinked after any of them changes
+	void _watchShaders(ShaderSources_t sources);
+
+	///
+	void _unwatchShaders();
+
+	/// Compiles and links shaders from files again, keeps current program if compilation or linking fails
+	void _reloadShaders();
+
+	ShaderSources_t _shaderSources;
+	std::vector<std::size_t> _shaderWatches;
+
 	UniMap_t _uniforms;
 	UniMap_t::iterator _currentElem = _uniforms.end();
 	const char* const _uniTypeNames[std::variant_size_v<UniVariant_t>] = { "bool", "bvec2", "bvec3", "bvec4", "int", "ivec2", "ivec3", "ivec4", "uint", "uvec2", "uvec3", "uvec4", "float", "vec2", "vec3", "vec4", "mat2x2", "mat3x3", "mat4x4" };
@@ -149,7 +237,26 @@ private:
 	///
 	void _finishLinking();
 
+	///
+	template <typename T, typename... Ts>
+	bool _setUniform(const char* name, const T& value, Ts... args);
+
+	///
+	template <typename T, typename... Ts>
+	bool _setUniform(UniformHandle handle, const T& value, Ts... args);
+
+	/// Location and last uploaded value of active uniform
+	struct _UniformInfo
+	{
+		GLint location;
+		bool hasShadow;
+		alignas(glm::mat4x4) unsigned char shadow[sizeof(glm::mat4x4)];
+	};
+
 	NativeHandle_t _program = 0;
+	std::size_t _revision = 0;
+	std::vector<_UniformInfo> _uniformInfos;
+	std::unordered_map<rat::Hash64_t, int> _uniformIndices;
 
 };
 
@@ -175,6 +282,12 @@ void ShaderProgram::linkShaders(Ts&&... shaders)
 	(glDetachShader(_program, shaders.getNativeHandle()), ...);
 
 	_finishLinking();
+
+	#ifdef EDITOR
+	{
+		_watchShaders({ { shaders._type, shaders._filePath }... });
+	}
+	#endif // EDITOR
 }
 
 }
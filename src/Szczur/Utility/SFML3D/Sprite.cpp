@@ -10,22 +10,36 @@ namespace sf3d
 
 /* Properties */
 void Sprite::setTexture(const Texture& texture)
+{
+	setTexture(texture, {0u, 0u}, texture.getSize());
+}
+
+void Sprite::setTexture(const Texture& texture, glm::uvec2 position, glm::uvec2 size)
 {
 	_texture = &texture;
 
-	const glm::vec2 size = texture.getSize();
+	const glm::vec2 extent = size;
+	const glm::vec2 textureSize = texture.getSize();
+
+	// Texture coordinates of the rectangle, whole texture if it is not created yet
+	glm::vec2 min {0.f, 0.f};
+	glm::vec2 max {1.f, 1.f};
+	if (textureSize.x > 0.f && textureSize.y > 0.f) {
+		min = glm::vec2(position) / textureSize;
+		max = (glm::vec2(position) + extent) / textureSize;
+	}
 
 	_vertices[0].position = {0.f, 0.f, 0.f};
-	_vertices[0].texCoord = {0.f, 0.f};
+	_vertices[0].texCoord = {min.x, min.y};
 
-	_vertices[1].position = {size.x, 0.f, 0.f};
-	_vertices[1].texCoord = {1.f, 0.f};
+	_vertices[1].position = {extent.x, 0.f, 0.f};
+	_vertices[1].texCoord = {max.x, min.y};
 
-	_vertices[2].position = {size.x, -size.y, 0.f};
-	_vertices[2].texCoord = {1.f, 1.f};
+	_vertices[2].position = {extent.x, -extent.y, 0.f};
+	_vertices[2].texCoord = {max.x, max.y};
 	
-	_vertices[3].position = {0.f, -size.y, 0.f};
-	_vertices[3].texCoord = {0.f, 1.f};
+	_vertices[3].position = {0.f, -extent.y, 0.f};
+	_vertices[3].texCoord = {min.x, max.y};
 }
 
 
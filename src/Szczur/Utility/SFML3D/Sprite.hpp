@@ -4,6 +4,8 @@
 #include "Drawable.hpp"
 #include "VertexArray.hpp"
 
+#include <glm/vec2.hpp>
+
 namespace sf3d
 {
 	class RenderTarget;
@@ -28,6 +30,9 @@ public:
 	/// Set new texture for sprite
 	void setTexture(const Texture& texture);
 
+	/// Set new texture for sprite, displaying only given rectangle of it (in pixels)
+	void setTexture(const Texture& texture, glm::uvec2 position, glm::uvec2 size);
+
 
 
 	/* Operators */
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <algorithm>
+#include <stdexcept>
+
+#include <glm/common.hpp>
+
+#include "Szczur/Utility/SFML3D/LightPoint.hpp"
+#include "Szczur/Utility/Tests.hpp"
+
+struct LightPointTest : public ::testing::Test
+{
+	static constexpr float threshold = 1.f / 256.f;
+
+	/// Strongest channel lit by light at given distance, as in `calucaltePointLight` of `world.frag` for surface facing the light and white texture
+	static float shade(const sf3d::LightPoint& light, float distance)
+	{
+		const auto& a = light.attenuation;
+		const float attenuation = 1.f / (a.constant + distance * (a.linear + distance * a.quadratic));
+		const glm::vec3 result = (light.ambientFactor + light.diffuseFactor * 1.f) * attenuation * light.color;
+		return std::max({ result.x, result.y, result.z });
+	}
+
+	/// Throws if shader still lights beyond radius or stops lighting before it
+	static void checkRadius(const sf3d::LightPoint& light, const char* message)
+	{
+		const float radius = light.getAttenuationRadius(threshold);
+		if (shade(light, radius * 0.99f) < threshold || shade(light, radius * 1.01f) >= threshold) {
+			throw std::runtime_error(message);
+		}
+	}
+};
+
+/// Radius used to select lights of objects has to end where shader falloff drops below threshold
+TEST_F(LightPointTest, AttenuationRadius)
+{
+	sf3d::LightPoint light;
+	light.setColor({ 1.f, 0.8f, 0.5f });
+	light.setSpecularFactor({ 0.f, 0.f, 0.f });
+
+	light.setAttenuation(sf3d::LightPoint::Attenuation{ 1.f, 0.01f, 0.001f });
+	light.setAmbientFactor({ 0.5f, 0.5f, 0.5f });
+	light.setDiffuseFactor({ 1.f, 1.f, 1.f });
+	checkRadius(light, "Radius of quadratic falloff differs from shader");
+
+	// Equal factors, sum is twice as bright as each of them
+	light.setAmbientFactor({ 1.f, 1.f, 1.f });
+	checkRadius(light, "Radius does not sum ambient and diffuse factors like shader");
+
+	light.setAttenuation(sf3d::LightPoint::Attenuation{ 1.f, 0.05f, 0.f });
+	checkRadius(light, "Radius of linear falloff differs from shader");
+}
@@ -3,6 +3,9 @@
 #include "Szczur/Utility/SFML3D/ShaderProgram.hpp"
 #include "Szczur/Utility/SFML3D/Shader.hpp"
 #include "Szczur/Utility/SFML3D/RectangleShape.hpp"
+#include "Szczur/Utility/SFML3D/Texture.hpp"
+#include "Szczur/Utility/SFML3D/Sprite.hpp"
+#include "Szczur/Utility/SFML3D/VertexArray.hpp"
 #include "./Fixtures/RenderTargetTest.hpp"
 #include "Szczur/Utility/Tests.hpp"
 
@@ -51,4 +54,58 @@ VISUAL_TEST_F(SimpleRenderTargetTest, DrawRotate)
 	renderTarget->draw(object);
 }
 
+VISUAL_TEST_F(SimpleRenderTargetTest, DrawBatched)
+{
+	sf3d::Texture texture({1u, 1u});
+	sf3d::Sprite sprite(texture);
+	sprite.setScale({0.1f, 0.1f, 1.f});
+
+	renderTarget->resetStatistics();
+	renderTarget->beginBatch();
+	for (int y = 0; y < 8; ++y) {
+		for (int x = 0; x < 8; ++x) {
+			sprite.setPosition({-0.8f + x * 0.2f, 0.8f - y * 0.2f, 0.f});
+			renderTarget->draw(sprite);
+		}
+	}
+	renderTarget->endBatch();
+
+	const sf3d::RenderStatistics& statistics = renderTarget->getStatistics();
+	if (statistics.drawCalls != 1 || statistics.batchedDraws != 64 || statistics.batchedVertices != 64 * 4 || statistics.batchedIndices != 64 * 6) {
+		throw std::runtime_error("Sprites sharing texture should be drawn in single batch");
+	}
+}
+
+VISUAL_TEST_F(SimpleRenderTargetTest, DrawIndexed)
+{
+	// Quad as two triangles sharing diagonal
+	sf3d::VertexArray vertices(4, sf3d::Triangles);
+	vertices[0].position = {-0.3f, -0.2f, 0.f};
+	vertices[1].position = { 0.3f, -0.2f, 0.f};
+	vertices[2].position = { 0.3f,  0.2f, 0.f};
+	vertices[3].position = {-0.3f,  0.2f, 0.f};
+	vertices.setIndices({0u, 1u, 2u, 0u, 2u, 3u});
+
+	renderTarget->resetStatistics();
+	renderTarget->draw(vertices);
+
+	if (!vertices.isIndexed() || vertices.getIndicesCount() != 6 || renderTarget->getStatistics().drawCalls != 1) {
+		throw std::runtime_error("Indexed vertices should be drawn by single call");
+	}
+}
+
+TEST_F(SimpleRenderTargetTest, UniformHandles)
+{
+	sf3d::UniformHandle model = shaderProgram.getUniformHandle("model");
+	if (!model.isValid() || shaderProgram.getUniformHandle("notExistingUniform").isValid()) {
+		throw std::runtime_error("Uniform handles should be resolved only for active uniforms");
+	}
+
+	glUseProgram(shaderProgram.getNativeHandle());
+	if (!shaderProgram.setUniform(model, glm::mat4(1.f)) || !shaderProgram.setUniform(model, glm::mat4(1.f))) {
+		throw std::runtime_error("Setting uniform by handle failed");
+	}
+	glUseProgram(0);
+}
+
 // @todo , more tests
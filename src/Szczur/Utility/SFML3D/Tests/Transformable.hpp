@@ -0,0 +1,134 @@
+#pragma once
+
+#include <cmath>
+#include <stdexcept>
+#include <vector>
+
+#include <glm/trigonometric.hpp> // radians
+
+#include "Szczur/Utility/SFML3D/Transformable.hpp"
+#include "Szczur/Utility/Time/Clock.hpp"
+#include "Szczur/Utility/Tests.hpp"
+
+struct TransformableBenchmark : public ::testing::Test
+{
+	static constexpr size_t transformablesCount = 10000;
+	static constexpr size_t framesCount = 100;
+
+	std::vector<sf3d::Transformable> transformables;
+
+	virtual void SetUp()
+	{
+		transformables.resize(transformablesCount);
+		for (size_t i = 0; i < transformablesCount; ++i) {
+			transformables[i].setPosition({ i * 1.f, 0.f, i * 2.f });
+			transformables[i].setOrigin({ 64.f, 128.f, 0.f });
+			transformables[i].setScale({ 0.5f, 0.5f, 1.f });
+		}
+	}
+
+	/// Matrix as built before it was cached, to check fast path against
+	static sf3d::Transform buildReference(const sf3d::Transformable& transformable)
+	{
+		sf3d::Transform transform;
+		transform.translate(transformable.getPosition());
+		transform.rotate(glm::radians(transformable.getRotation().x), {1.f, 0.f, 0.f});
+		transform.rotate(glm::radians(transformable.getRotation().y), {0.f, 1.f, 0.f});
+		transform.rotate(glm::radians(transformable.getRotation().z), {0.f, 0.f, 1.f});
+		transform.translate(-(transformable.getOrigin() * transformable.getScale()));
+		transform.scale(transformable.getScale());
+		return transform;
+	}
+
+	/// Throws if cached matrix differs from full build
+	static void checkMatches(const sf3d::Transformable& transformable, const char* message)
+	{
+		const glm::mat4& cached = transformable.getTransform().getMatrix();
+		const glm::mat4 reference = buildReference(transformable).getMatrix();
+		for (int column = 0; column < 4; ++column) {
+			for (int row = 0; row < 4; ++row) {
+				if (std::abs(cached[column][row] - reference[column][row]) > 0.001f) {
+					throw std::runtime_error(message);
+				}
+			}
+		}
+	}
+
+	/// Time of building matrices each frame, moving every transformable first if asked
+	float measure(bool moving)
+	{
+		float sum = 0.f;
+		rat::Clock clock;
+		for (size_t frame = 0; frame < framesCount; ++frame) {
+			for (auto& transformable : transformables) {
+				if (moving) {
+					transformable.move({ 1.f, 0.f, 0.f });
+				}
+				sum += transformable.getTransform().getMatrix()[3][0];
+			}
+		}
+		const float time = clock.getElapsedTime().asFSeconds();
+
+		// Keeps compiler from dropping the loop
+		if (std::isnan(sum)) {
+			LOG_INFO("Sum is NaN");
+		}
+		return time * 1000.f / framesCount;
+	}
+};
+
+/// Rebuilding matrices of moving sprites with and without rotation, against cached matrices of still ones
+TEST_F(TransformableBenchmark, Build)
+{
+	for (auto& transformable : transformables) {
+		checkMatches(transformable, "Unrotated matrix differs from full build");
+	}
+
+	float referenceSum = 0.f;
+	rat::Clock clock;
+	for (size_t frame = 0; frame < framesCount; ++frame) {
+		for (auto& transformable : transformables) {
+			referenceSum += buildReference(transformable).getMatrix()[3][0];
+		}
+	}
+	const float referenceTime = clock.getElapsedTime().asFSeconds() * 1000.f / framesCount;
+	if (std::isnan(referenceSum)) {
+		LOG_INFO("Sum is NaN");
+	}
+
+	const float unrotatedTime = measure(true);
+	const float cachedTime = measure(false);
+
+	for (auto& transformable : transformables) {
+		transformable.setRotation({ 0.f, 0.f, 15.f });
+	}
+	const float rotatedTime = measure(true);
+
+	LOG_INFO("Transforms of ", transformablesCount, " transformables: full build ", referenceTime, " ms, unrotated ", unrotatedTime, " ms, rotated ", rotatedTime, " ms, cached ", cachedTime, " ms per frame");
+}
+
+/// Every change after matrix was built has to rebuild it
+TEST_F(TransformableBenchmark, Invalidation)
+{
+	sf3d::Transformable transformable;
+
+	auto check = [&](const char* message, auto change) {
+		const glm::mat4 previous = transformable.getTransform().getMatrix();
+		change();
+		if (transformable.getTransform().getMatrix() == previous) {
+			throw std::runtime_error(message);
+		}
+		checkMatches(transformable, message);
+	};
+
+	check("Matrix not rebuilt after setPosition", [&] { transformable.setPosition({ 10.f, 20.f, 30.f }); });
+	check("Matrix not rebuilt after move", [&] { transformable.move({ 5.f, 0.f, 0.f }); });
+	check("Matrix not rebuilt after setScale", [&] { transformable.setScale({ 2.f, 2.f, 1.f }); });
+	check("Matrix not rebuilt after scale", [&] { transformable.scale({ 0.5f, 1.f, 1.f }); });
+	check("Matrix not rebuilt after setOrigin", [&] { transformable.setOrigin({ 64.f, 128.f, 0.f }); });
+	check("Matrix not rebuilt after setRotation", [&] { transformable.setRotation({ 0.f, 0.f, 15.f }); });
+	check("Matrix not rebuilt after rotate", [&] { transformable.rotate({ 0.f, 30.f, 0.f }); });
+
+	// Moving rotated transformable takes other path than unrotated one
+	check("Matrix not rebuilt after moving rotated", [&] { transformable.move({ 0.f, 0.f, -5.f }); });
+}
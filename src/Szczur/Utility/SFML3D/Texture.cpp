@@ -46,6 +46,9 @@ Texture::Texture(Texture&& other)
 Texture& Texture::operator = (Texture&& other)
 {
 	if (this != &other) {
+		if (this->textureID) {
+			glDeleteTextures(1, &(this->textureID));
+		}
 		this->textureID = other.textureID; 
 		this->size      = other.size;
 		other.textureID = 0u;
@@ -90,27 +93,35 @@ void Texture::create(glm::vec2 size)
 
 void Texture::loadFromFile(const char* path)
 {
-	if (this->textureID) {
-		glDeleteTextures(1, &(this->textureID));
-	}
-
 	// Load texture file
 	sf::Image image;
 	if (!image.loadFromFile(path)) {
 		throw std::runtime_error(std::string("Cannot load texture from ") + path);
 	}
 
-	auto size = image.getSize();
-	this->size.x = size.x;
-	this->size.y = size.y;
+	this->loadFromMemory(image.getPixelsPtr(), {image.getSize().x, image.getSize().y});
+}
+void Texture::loadFromFile(const std::string& path)
+{
+	this->loadFromFile(path.c_str());
+}
+
+void Texture::loadFromMemory(const void* pixels, glm::uvec2 size)
+{
+	if (this->textureID) {
+		glDeleteTextures(1, &(this->textureID));
+	}
+	glGenTextures(1, &(this->textureID));
+
+	this->size = size;
 	
 	// Load into graphics 
 	glBindTexture(GL_TEXTURE_2D, this->textureID);
 	glTexImage2D(
 		GL_TEXTURE_2D, 0, GL_RGBA,
-		image.getSize().x, image.getSize().y,
+		size.x, size.y,
 		0,
-		GL_RGBA, GL_UNSIGNED_BYTE, image.getPixelsPtr()
+		GL_RGBA, GL_UNSIGNED_BYTE, pixels
 	);
 	glGenerateMipmap(GL_TEXTURE_2D);
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
@@ -119,10 +130,6 @@ void Texture::loadFromFile(const char* path)
 	glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_BORDER);
 	glBindTexture(GL_TEXTURE_2D, 0);
 }
-void Texture::loadFromFile(const std::string& path)
-{
-	this->loadFromFile(path.c_str());
-}
 
 void Texture::bind() const noexcept
 {
@@ -53,6 +53,9 @@ public:
 	void loadFromFile(const char* path);
 	void loadFromFile(const std::string& path);
 
+	/// Uploads RGBA pixels, decoded earlier (for example in other thread)
+	void loadFromMemory(const void* pixels, glm::uvec2 size);
+
 	void bind() const noexcept;
 	void unbind() const noexcept;
 };
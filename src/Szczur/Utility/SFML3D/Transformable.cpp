@@ -1,10 +1,9 @@
 #include "Transformable.hpp"
 
 #include <glm/vec3.hpp>
+#include <glm/vec4.hpp>
 #include <glm/trigonometric.hpp> // radians
 
-#include "Transform.hpp"
-
 namespace sf3d
 {
 
@@ -13,6 +12,7 @@ namespace sf3d
 void Transformable::setPosition(const glm::vec3& position)
 {
 	_position = position;
+	_transformNeedsUpdate = true;
 }
 const glm::vec3& Transformable::getPosition() const
 {
@@ -23,6 +23,7 @@ const glm::vec3& Transformable::getPosition() const
 void Transformable::setRotation(const glm::vec3& direction)
 {
 	_rotation = direction;
+	_transformNeedsUpdate = true;
 }
 const glm::vec3& Transformable::getRotation() const
 {
@@ -33,6 +34,7 @@ const glm::vec3& Transformable::getRotation() const
 void Transformable::setScale(const glm::vec3& value)
 {
 	_scale = value;
+	_transformNeedsUpdate = true;
 }
 const glm::vec3& Transformable::getScale() const
 {
@@ -45,6 +47,7 @@ void Transformable::setOrigin(const glm::vec3& position)
 	_origin.x = position.x;
 	_origin.y = -position.y; // @warn To chyba nie powinno być na tym etapie, bo set(x) =/= x=gett()...
 	_origin.z = position.z;
+	_transformNeedsUpdate = true;
 }
 const glm::vec3& Transformable::getOrigin() const
 {
@@ -74,31 +77,50 @@ Transformable::Transformable(
 void Transformable::move(const glm::vec3& offset)
 {
 	_position += offset;
+	_transformNeedsUpdate = true;
 }
 
 
 void Transformable::rotate(const glm::vec3& direction)
 {
 	_rotation += direction;
+	_transformNeedsUpdate = true;
 }
 
 
 void Transformable::scale(const glm::vec3& value)
 {
 	_scale *= value;
+	_transformNeedsUpdate = true;
 }
 
-Transform Transformable::getTransform() const
+const Transform& Transformable::getTransform() const
 {
-	Transform transform;
-	transform.translate(_position);
-	transform.rotate(glm::radians(_rotation.x), {1.f, 0.f, 0.f});
-	transform.rotate(glm::radians(_rotation.y), {0.f, 1.f, 0.f});
-	transform.rotate(glm::radians(_rotation.z), {0.f, 0.f, 1.f});
-	transform.translate(-(_origin*_scale));
-	transform.scale(_scale);
-
-	return transform;
+	if (!_transformNeedsUpdate) {
+		return _transform;
+	}
+	_transformNeedsUpdate = false;
+
+	if (_rotation == glm::vec3(0.f)) {
+		// Nearly all sprites are not rotated, matrix is just scale and translation
+		glm::mat4& matrix = _transform.getMatrix();
+		matrix = glm::mat4(1.f);
+		matrix[0][0] = _scale.x;
+		matrix[1][1] = _scale.y;
+		matrix[2][2] = _scale.z;
+		matrix[3] = glm::vec4(_position - _origin * _scale, 1.f);
+		return _transform;
+	}
+
+	_transform = Transform();
+	_transform.translate(_position);
+	_transform.rotate(glm::radians(_rotation.x), {1.f, 0.f, 0.f});
+	_transform.rotate(glm::radians(_rotation.y), {0.f, 1.f, 0.f});
+	_transform.rotate(glm::radians(_rotation.z), {0.f, 0.f, 1.f});
+	_transform.translate(-(_origin*_scale));
+	_transform.scale(_scale);
+
+	return _transform;
 }
 
 }
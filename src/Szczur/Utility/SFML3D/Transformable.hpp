@@ -2,9 +2,7 @@
 
 #include <glm/vec3.hpp>
 
-namespace sf3d {
-	class Transform;
-}
+#include "Transform.hpp"
 
 namespace sf3d
 {
@@ -20,6 +18,10 @@ private:
 
 	glm::vec3 _origin 	{0.f, 0.f, 0.f};
 
+	// Built on first `getTransform` after change, not safe to build from many threads at once
+	mutable Transform _transform;
+	mutable bool _transformNeedsUpdate {true};
+
 
 
 	/* Properties */
@@ -65,8 +67,8 @@ public:
 	void scale(const glm::vec3& value);
 	//void scale(float value); // @todo ,
 
-	/// Returns calculated Transform (matrix).
-	Transform getTransform() const;
+	/// Returns calculated Transform (matrix), rebuilt only if something has changed since last call
+	const Transform& getTransform() const;
 };
 
 }
\ No newline at end of file
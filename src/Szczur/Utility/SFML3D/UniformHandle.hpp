@@ -0,0 +1,39 @@
+#pragma once
+
+namespace sf3d
+{
+
+/// Identifies active uniform of shader program, resolved once after linking
+class UniformHandle
+{
+public:
+
+	///
+	UniformHandle() = default;
+
+	///
+	explicit UniformHandle(int index)
+		: _index { index }
+	{
+
+	}
+
+	///
+	bool isValid() const
+	{
+		return _index != -1;
+	}
+
+	///
+	int getIndex() const
+	{
+		return _index;
+	}
+
+private:
+
+	int _index = -1;
+
+};
+
+}
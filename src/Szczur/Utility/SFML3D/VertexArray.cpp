@@ -24,10 +24,13 @@ VertexArray::VertexArray(PrimitiveType type)
     , _type { type }
     , _vao { 0 }
     , _vbo { 0 }
+    , _indices {}
+    , _ebo { 0 }
     , _lowerIndex { maxIndex }
     , _upperIndex { minIndex }
     , _needsUpdate { false }
     , _needsReallocate { false }
+    , _indicesNeedUpdate { false }
 {
     _init();
 }
@@ -37,10 +40,13 @@ VertexArray::VertexArray(size_t size, PrimitiveType type)
     , _type { type }
     , _vao { 0 }
     , _vbo { 0 }
+    , _indices {}
+    , _ebo { 0 }
     , _lowerIndex { maxIndex }
     , _upperIndex { minIndex }
     , _needsUpdate { false }
     , _needsReallocate { false }
+    , _indicesNeedUpdate { false }
 {
     _init();
 }
@@ -50,10 +56,13 @@ VertexArray::VertexArray(size_t size, const Vertex& value, PrimitiveType type)
     , _type { type }
     , _vao { 0 }
     , _vbo { 0 }
+    , _indices {}
+    , _ebo { 0 }
     , _lowerIndex { maxIndex }
     , _upperIndex { minIndex }
     , _needsUpdate { false }
     , _needsReallocate { false }
+    , _indicesNeedUpdate { false }
 {
     _init();
 }
@@ -63,10 +72,13 @@ VertexArray::VertexArray(const Vertex* vertices, size_t size, PrimitiveType type
     , _type { type }
     , _vao { 0 }
     , _vbo { 0 }
+    , _indices {}
+    , _ebo { 0 }
     , _lowerIndex { maxIndex }
     , _upperIndex { minIndex }
     , _needsUpdate { false }
     , _needsReallocate { false }
+    , _indicesNeedUpdate { false }
 {
     _init();
 }
@@ -76,10 +88,13 @@ VertexArray::VertexArray(const Vertex* begin, const Vertex* end, PrimitiveType t
     , _type { type }
     , _vao { 0 }
     , _vbo { 0 }
+    , _indices {}
+    , _ebo { 0 }
     , _lowerIndex { maxIndex }
     , _upperIndex { minIndex }
     , _needsUpdate { false }
     , _needsReallocate { false }
+    , _indicesNeedUpdate { false }
 {
     _init();
 }
@@ -87,7 +102,7 @@ VertexArray::VertexArray(const Vertex* begin, const Vertex* end, PrimitiveType t
 VertexArray::VertexArray(const VertexArray& rhs)
     : VertexArray { rhs._vertices.data(), rhs._vertices.size(), rhs._type }
 {
-
+    setIndices(rhs._indices);
 }
 
 VertexArray& VertexArray::operator = (const VertexArray& rhs)
@@ -100,6 +115,8 @@ VertexArray& VertexArray::operator = (const VertexArray& rhs)
         _type = rhs._type;
 
         _init();
+
+        setIndices(rhs._indices);
     }
 
     return *this;
@@ -110,17 +127,22 @@ VertexArray::VertexArray(VertexArray&& rhs) noexcept
     , _type { rhs._type }
     , _vao { rhs._vao }
     , _vbo { rhs._vbo }
+    , _indices { std::move(rhs._indices) }
+    , _ebo { rhs._ebo }
     , _lowerIndex { rhs._lowerIndex }
     , _upperIndex { rhs._upperIndex }
     , _needsUpdate { rhs._needsUpdate }
     , _needsReallocate { rhs._needsReallocate }
+    , _indicesNeedUpdate { rhs._indicesNeedUpdate }
 {
     rhs._vao = 0;
     rhs._vbo = 0;
+    rhs._ebo = 0;
     rhs._lowerIndex = maxIndex;
     rhs._upperIndex = minIndex;
     rhs._needsUpdate = false;
     rhs._needsReallocate = false;
+    rhs._indicesNeedUpdate = false;
 }
 
 VertexArray& VertexArray::operator = (VertexArray&& rhs) noexcept
@@ -133,17 +155,22 @@ VertexArray& VertexArray::operator = (VertexArray&& rhs) noexcept
         _type = rhs._type;
         _vao = rhs._vao;
         _vbo = rhs._vbo;
+        _indices = std::move(rhs._indices);
+        _ebo = rhs._ebo;
         _lowerIndex = rhs._lowerIndex;
         _upperIndex = rhs._upperIndex;
         _needsUpdate = rhs._needsUpdate;
         _needsReallocate = rhs._needsReallocate;
+        _indicesNeedUpdate = rhs._indicesNeedUpdate;
 
         rhs._vao = 0;
         rhs._vbo = 0;
+        rhs._ebo = 0;
         rhs._lowerIndex = maxIndex;
         rhs._upperIndex = minIndex;
         rhs._needsReallocate = false;
         rhs._needsUpdate = false;
+        rhs._indicesNeedUpdate = false;
     }
 
     return *this;
@@ -330,6 +357,43 @@ bool VertexArray::isEmpty() const
     return _vertices.empty();
 }
 
+void VertexArray::setIndices(const GLuint* indices, size_t count)
+{
+    _indices.assign(indices, indices + count);
+
+    _indicesNeedUpdate = true;
+}
+
+void VertexArray::setIndices(const Indices_t& indices)
+{
+    setIndices(indices.data(), indices.size());
+}
+
+void VertexArray::clearIndices()
+{
+    if (!_indices.empty())
+    {
+        _indices.clear();
+
+        _indicesNeedUpdate = true;
+    }
+}
+
+const VertexArray::Indices_t& VertexArray::getIndices() const
+{
+    return _indices;
+}
+
+size_t VertexArray::getIndicesCount() const
+{
+    return _indices.size();
+}
+
+bool VertexArray::isIndexed() const
+{
+    return !_indices.empty();
+}
+
 bool VertexArray::isValid() const
 {
     return _vao != 0 && _vbo != 0;
@@ -414,6 +478,24 @@ void VertexArray::update() const
 
         unbind();
     }
+
+    if (_indicesNeedUpdate && _vao != 0 && !_indices.empty())
+    {
+        // Element buffer is state of vertex array object, so it stays attached after unbinding
+        glBindVertexArray(_vao);
+
+        if (_ebo == 0)
+        {
+            glGenBuffers(1, &_ebo);
+        }
+
+        glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, _ebo);
+        glBufferData(GL_ELEMENT_ARRAY_BUFFER, _indices.size() * sizeof(GLuint), _indices.data(), GL_STATIC_DRAW);
+
+        glBindVertexArray(0);
+    }
+
+    _indicesNeedUpdate = false;
 }
 
 void VertexArray::draw(RenderTarget& target, RenderStates states) const
@@ -452,11 +534,19 @@ void VertexArray::_destroy()
     glDeleteBuffers(1, &_vbo);
     _vbo = 0;
 
+    if (_ebo != 0)
+    {
+        glDeleteBuffers(1, &_ebo);
+        _ebo = 0;
+    }
+    _indices.clear();
+
     _lowerIndex = maxIndex;
     _upperIndex = minIndex;
 
     _needsUpdate = false;
     _needsReallocate = false;
+    _indicesNeedUpdate = false;
 }
 
 }
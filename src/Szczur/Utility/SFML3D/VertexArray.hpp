@@ -18,6 +18,7 @@ class VertexArray : public Drawable
 public:
 
     using Vertices_t = std::vector<Vertex>;
+    using Indices_t = std::vector<GLuint>;
 
     ///
     VertexArray() = delete;
@@ -109,6 +110,24 @@ public:
     ///
     bool isEmpty() const;
 
+    /// Vertices are drawn in order of indices, so vertex shared by many primitives is stored once. Empty indices draw vertices in order
+    void setIndices(const GLuint* indices, size_t count);
+
+    ///
+    void setIndices(const Indices_t& indices);
+
+    ///
+    void clearIndices();
+
+    ///
+    const Indices_t& getIndices() const;
+
+    ///
+    size_t getIndicesCount() const;
+
+    ///
+    bool isIndexed() const;
+
     ///
     bool isValid() const;
 
@@ -139,10 +158,13 @@ private:
     PrimitiveType _type;
     GLuint _vao;
     GLuint _vbo;
+    Indices_t _indices;
+    mutable GLuint _ebo;
     mutable size_t _lowerIndex;
     mutable size_t _upperIndex;
     mutable bool _needsUpdate;
     mutable bool _needsReallocate;
+    mutable bool _indicesNeedUpdate;
 
 };
 
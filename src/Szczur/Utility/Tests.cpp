@@ -21,6 +21,10 @@ std::vector<TesterInvoker*> tests;
 #include "Szczur/Utility/SFML3D/Tests/RenderTarget.hpp"
 #include "Szczur/Utility/SFML3D/Tests/RenderLayer.hpp"
 #include "Szczur/Utility/SFML3D/Tests/Other/Test001.hpp"
+#include "Szczur/Utility/SFML3D/Tests/Transformable.hpp"
+#include "Szczur/Utility/SFML3D/Tests/LightPoint.hpp"
+#include "Szczur/Modules/World/Tests/Entities.hpp"
+#include "Szczur/Modules/DragonBones/Tests/Skinning.hpp"
 
 
 